@@ -0,0 +1,42 @@
+/*
+ * Input generator for POJ 1182
+ * 
+ * usage: gen-1182 [N] [K] [seed] [shape]
+ * 
+ * N animals and K statements of `shape`:
+ * 
+ * - random: random statements, about 1% of them refer to an
+ *   animal out of range, like the original input does
+ * - chain: statement `i` relates animal i+2 to i+1 (modulo N-1),
+ *   which builds a chain of depth N if the new animal becomes the
+ *   root each time
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rng.h"
+
+int main(int argc, char** argv) {
+  int N = arg_or(argc, argv, 1, 65535);
+  int K = arg_or(argc, argv, 2, 100000);
+  rng_seed(arg_or(argc, argv, 3, 1182));
+  const char* shape = argc > 4 ? argv[4] : "random";
+
+  printf("%d %d\n", N, K);
+  if (!strcmp(shape, "chain")) {
+    for (int i = 0; i < K; i++) {
+      int x = i % (N-1) + 2;
+      printf("%d %d %d\n", (int)rng_range(1, 2), x, x-1);
+    }
+    return 0;
+  }
+
+  for (int i = 0; i < K; i++) {
+    int x = rng_range(1, N), y = rng_range(1, N);
+    if (rng_range(0, 99) == 0) x = N+1;
+    printf("%d %d %d\n", (int)rng_range(1, 2), x, y);
+  }
+
+  return 0;
+}
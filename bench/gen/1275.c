@@ -0,0 +1,32 @@
+/*
+ * Input generator for POJ 1275
+ * 
+ * usage: gen-1275 [cases] [M] [seed]
+ * 
+ * Each case has M applicants starting at random hours, and
+ * requirements of at most M/24 per hour, while about M/3 of the
+ * applicants could work at any hour. So nearly every case is
+ * feasible, and all cases of the bench inputs are, which keeps
+ * solvers on the search for the least number of cashiers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+
+int main(int argc, char** argv) {
+  int cases = arg_or(argc, argv, 1, 100);
+  int M = arg_or(argc, argv, 2, 1000);
+  rng_seed(arg_or(argc, argv, 3, 1275));
+
+  printf("%d\n", cases);
+  for (int c = 0; c < cases; c++) {
+    for (int i = 0; i < 24; i++)
+      printf("%d%c", (int)rng_range(0, M/24), i == 23 ? '\n' : ' ');
+    printf("%d\n", M);
+    for (int i = 0; i < M; i++)
+      printf("%d\n", (int)rng_range(0, 23));
+  }
+
+  return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * Input generator for POJ 1417
+ * 
+ * usage: gen-1417 [cases] [n] [p1] [p2] [seed]
+ * 
+ * Each case hides a divine/devilish assignment of p1+p2 people,
+ * and asks n random questions which are answered honestly by
+ * the divine and falsely by the devilish.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+
+int main(int argc, char** argv) {
+  int cases = arg_or(argc, argv, 1, 100);
+  int n = arg_or(argc, argv, 2, 1000);
+  int p1 = arg_or(argc, argv, 3, 299);
+  int p2 = arg_or(argc, argv, 4, 299);
+  rng_seed(arg_or(argc, argv, 5, 1417));
+
+  int total = p1 + p2;
+  int* divine = malloc(sizeof(int) * (total+1));
+
+  for (int c = 0; c < cases; c++) {
+
+    // Shuffle p1 divine ones among all people
+    for (int i = 1; i <= total; i++) divine[i] = i <= p1;
+    for (int i = total; i > 1; i--) {
+      int j = rng_range(1, i), tmp = divine[i];
+      divine[i] = divine[j], divine[j] = tmp;
+    }
+
+    printf("%d %d %d\n", n, p1, p2);
+    for (int i = 0; i < n; i++) {
+      int x = rng_range(1, total), y = rng_range(1, total);
+      int says_yes = divine[x] ? divine[y] : !divine[y];
+      printf("%d %d %s\n", x, y, says_yes ? "yes" : "no");
+    }
+  }
+  printf("0 0 0\n");
+
+  free(divine);
+  return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Input generator for POJ 1470
+ * 
+ * usage: gen-1470 [cases] [n] [queries] [shape] [seed]
+ * 
+ * Trees on shuffled labels, with the extra blanks and line breaks
+ * between queries that the problem warns about. See tree.h for
+ * shapes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+#include "tree.h"
+
+int main(int argc, char** argv) {
+  int cases = arg_or(argc, argv, 1, 10);
+  int n = arg_or(argc, argv, 2, 999);
+  int q = arg_or(argc, argv, 3, 100000);
+  const char* shape = argc > 4 ? argv[4] : "random";
+  rng_seed(arg_or(argc, argv, 5, 1470));
+
+  int* label = malloc(sizeof(int) * (n+1));
+  int* parent = malloc(sizeof(int) * (n+1));
+  int* num_child = malloc(sizeof(int) * (n+1));
+
+  for (int c = 0; c < cases; c++) {
+    for (int i = 1; i <= n; i++) label[i] = i, num_child[i] = 0;
+    for (int i = n; i > 1; i--) {
+      int j = rng_range(1, i), tmp = label[i];
+      label[i] = label[j], label[j] = tmp;
+    }
+
+    for (int i = 2; i <= n; i++) {
+      parent[i] = tree_parent(shape, i);
+      num_child[parent[i]]++;
+    }
+
+    printf("%d\n", n);
+    for (int i = 1; i <= n; i++) {
+      printf("%d:(%d)", label[i], num_child[i]);
+      for (int j = i+1; j <= n; j++)
+        if (parent[j] == i) printf(" %d", label[j]);
+      putchar('\n');
+    }
+
+    printf("%d\n", q);
+    for (int i = 0; i < q; i++) {
+      printf("(%d %d)%s", label[rng_range(1, n)], label[rng_range(1, n)],
+        rng_range(0, 7) ? "  " : "\n   ");
+    }
+    putchar('\n');
+  }
+
+  free(label);
+  free(parent);
+  free(num_child);
+  return 0;
+}
@@ -0,0 +1,33 @@
+/*
+ * Input generator for POJ 1986
+ * 
+ * usage: gen-1986 [N] [K] [shape] [seed] [cases]
+ * 
+ * A tree of N farms connected by N-1 roads, and K distance
+ * queries, repeated for `cases` cases. See tree.h for shapes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+#include "tree.h"
+
+int main(int argc, char** argv) {
+  int N = arg_or(argc, argv, 1, 40000);
+  int K = arg_or(argc, argv, 2, 10000);
+  const char* shape = argc > 3 ? argv[3] : "random";
+  rng_seed(arg_or(argc, argv, 4, 1986));
+  int cases = arg_or(argc, argv, 5, 1);
+
+  for (int c = 0; c < cases; c++) {
+    printf("%d %d\n", N, N-1);
+    for (int i = 2; i <= N; i++)
+      printf("%d %d %d %c\n", tree_parent(shape, i), i, (int)rng_range(1, 1000), "NESW"[rng_range(0, 3)]);
+
+    printf("%d\n", K);
+    for (int i = 0; i < K; i++)
+      printf("%d %d\n", (int)rng_range(1, N), (int)rng_range(1, N));
+  }
+
+  return 0;
+}
@@ -0,0 +1,23 @@
+/*
+ * Input generator for POJ 1990
+ * 
+ * usage: gen-1990 [N] [max_x] [seed]
+ * 
+ * N cows with random thresholds and x axes in [1, max_x].
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+
+int main(int argc, char** argv) {
+  int N = arg_or(argc, argv, 1, 20000);
+  int max_x = arg_or(argc, argv, 2, 20000);
+  rng_seed(arg_or(argc, argv, 3, 1990));
+
+  printf("%d\n", N);
+  for (int i = 0; i < N; i++)
+    printf("%d %d\n", (int)rng_range(1, 20000), (int)rng_range(1, max_x));
+
+  return 0;
+}
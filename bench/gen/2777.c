@@ -0,0 +1,28 @@
+/*
+ * Input generator for POJ 2777
+ * 
+ * usage: gen-2777 [L] [T] [O] [seed]
+ * 
+ * O operations on a board of length L with T colors, half
+ * paints and half queries. Ranges may come in reversed order.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+
+int main(int argc, char** argv) {
+  int L = arg_or(argc, argv, 1, 100000);
+  int T = arg_or(argc, argv, 2, 30);
+  int O = arg_or(argc, argv, 3, 100000);
+  rng_seed(arg_or(argc, argv, 4, 2777));
+
+  printf("%d %d %d\n", L, T, O);
+  for (int i = 0; i < O; i++) {
+    int a = rng_range(1, L), b = rng_range(1, L);
+    if (rng_range(0, 1)) printf("C %d %d %d\n", a, b, (int)rng_range(1, T));
+    else printf("P %d %d\n", a, b);
+  }
+
+  return 0;
+}
@@ -0,0 +1,27 @@
+/*
+ * Input generator for POJ 3159
+ * 
+ * usage: gen-3159 [N] [M] [max_c] [seed] [min_c]
+ * 
+ * M random constraints between N kids, with c in [min_c, max_c].
+ * A negative `min_c` makes graphs with negative cycles, where the
+ * constraints have no solution.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+
+int main(int argc, char** argv) {
+  int N = arg_or(argc, argv, 1, 30000);
+  int M = arg_or(argc, argv, 2, 150000);
+  int max_c = arg_or(argc, argv, 3, 10000);
+  rng_seed(arg_or(argc, argv, 4, 3159));
+  int min_c = arg_or(argc, argv, 5, 0);
+
+  printf("%d %d\n", N, M);
+  for (int i = 0; i < M; i++)
+    printf("%d %d %d\n", (int)rng_range(1, N), (int)rng_range(1, N), (int)rng_range(min_c, max_c));
+
+  return 0;
+}
@@ -0,0 +1,27 @@
+/*
+ * Input generator for POJ 3277
+ * 
+ * usage: gen-3277 [N] [seed]
+ * 
+ * N buildings with random [A, B) and heights in [1, 1e9].
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+
+#define MAX_COORD 1000000000
+
+int main(int argc, char** argv) {
+  int N = arg_or(argc, argv, 1, 49999);
+  rng_seed(arg_or(argc, argv, 2, 3277));
+
+  printf("%d\n", N);
+  for (int i = 0; i < N; i++) {
+    int a = rng_range(1, MAX_COORD-1);
+    int b = rng_range(a+1, MAX_COORD);
+    printf("%d %d %d\n", a, b, (int)rng_range(1, MAX_COORD));
+  }
+
+  return 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * Input generator for POJ 3294
+ * 
+ * usage: gen-3294 [cases] [n] [len] [alpha] [seed]
+ * 
+ * Each case has n random strings of length `len` over the first
+ * `alpha` lowercase letters. Small alphabets make long common
+ * substrings likely.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+
+int main(int argc, char** argv) {
+  int cases = arg_or(argc, argv, 1, 3);
+  int n = arg_or(argc, argv, 2, 100);
+  int len = arg_or(argc, argv, 3, 1000);
+  int alpha = arg_or(argc, argv, 4, 4);
+  rng_seed(arg_or(argc, argv, 5, 3294));
+
+  for (int c = 0; c < cases; c++) {
+    printf("%d\n", n);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < len; j++) putchar('a' + rng_range(0, alpha-1));
+      putchar('\n');
+    }
+  }
+  printf("0\n");
+
+  return 0;
+}
@@ -0,0 +1,39 @@
+/*
+ * Input generator for POJ 3321
+ * 
+ * usage: gen-3321 [N] [M] [shape] [seed] [burst]
+ * 
+ * A tree of N forks rooted at 1, and M operations, half changes
+ * and half queries. See tree.h for shapes.
+ * 
+ * Operations come in runs of the same kind, `burst` long on
+ * average; the default 1 flips a coin for each operation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+#include "tree.h"
+
+int main(int argc, char** argv) {
+  int N = arg_or(argc, argv, 1, 100000);
+  int M = arg_or(argc, argv, 2, 100000);
+  const char* shape = argc > 3 ? argv[3] : "random";
+  rng_seed(arg_or(argc, argv, 4, 3321));
+  int burst = arg_or(argc, argv, 5, 1);
+
+  printf("%d\n", N);
+  for (int i = 2; i <= N; i++)
+    printf("%d %d\n", tree_parent(shape, i), i);
+
+  printf("%d\n", M);
+  int change = 0;
+  for (int i = 0; i < M; i++) {
+    int fork = rng_range(1, N);
+    if (burst <= 1) change = rng_range(0, 1);
+    else if (rng_range(1, burst) == 1) change = !change;
+    printf("%c %d\n", change ? 'C' : 'Q', fork);
+  }
+
+  return 0;
+}
@@ -0,0 +1,31 @@
+/*
+ * Input generator for POJ 3415
+ * 
+ * usage: gen-3415 [cases] [len] [K] [alpha] [seed]
+ * 
+ * Each case has two random strings of length `len` over the
+ * first `alpha` lowercase letters.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+
+int main(int argc, char** argv) {
+  int cases = arg_or(argc, argv, 1, 1);
+  int len = arg_or(argc, argv, 2, 99999);
+  int K = arg_or(argc, argv, 3, 1);
+  int alpha = arg_or(argc, argv, 4, 2);
+  rng_seed(arg_or(argc, argv, 5, 3415));
+
+  for (int c = 0; c < cases; c++) {
+    printf("%d\n", K);
+    for (int s = 0; s < 2; s++) {
+      for (int j = 0; j < len; j++) putchar('a' + rng_range(0, alpha-1));
+      putchar('\n');
+    }
+  }
+  printf("0\n");
+
+  return 0;
+}
@@ -0,0 +1,34 @@
+/*
+ * Deterministic random numbers for input generators
+ * 
+ * splitmix64, so that the same seed always produces the same
+ * input on every machine, unlike rand().
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+static unsigned long long rng_state;
+
+static void rng_seed(unsigned long long seed) {
+  rng_state = seed;
+}
+
+static unsigned long long rng_next(void) {
+  unsigned long long z = (rng_state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// A random integer in [lo, hi].
+static long long rng_range(long long lo, long long hi) {
+  return lo + (long long)(rng_next() % (unsigned long long)(hi - lo + 1));
+}
+
+// Parse argv[i] as a number, or fall back to `def`.
+static long long arg_or(int argc, char** argv, int i, long long def) {
+  return i < argc ? atoll(argv[i]) : def;
+}
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * Tree shapes for input generators
+ * 
+ * Nodes are labeled 1..n and node 1 is the root, so a tree is
+ * described by the parent of each node 2..n:
+ * 
+ * - random: a random earlier node, so the depth is O(log n)
+ * - chain: the previous node, a path of depth n
+ * - caterpillar: odd nodes form a path, and each even node hangs
+ *   on the odd node right before it, depth n/2
+ * 
+ * Chains and caterpillars are the worst cases for recursive DFS.
+ */
+
+#ifndef TREE_H
+#define TREE_H
+
+#include <string.h>
+#include "rng.h"
+
+static int tree_parent(const char* shape, int i) {
+  if (!strcmp(shape, "chain")) return i-1;
+  if (!strcmp(shape, "caterpillar")) return i == 2 ? 1 : (i % 2 ? i-2 : i-1);
+  return rng_range(1, i-1);
+}
+
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Benchmark harness
+ * 
+ * Run a solver with stdin redirected from an input file, and
+ * report its wall time, peak RSS and throughput. The output of
+ * the solver is hashed instead of printed, so that different
+ * modes of a solver could be checked against each other.
+ * 
+ * Solvers map their input file into memory (see lib/fastio.h),
+ * and the mapped pages count towards the peak RSS, which then
+ * mostly tells the size of the input. So the solver runs twice:
+ * the timed run reads the file, and the peak RSS is taken from a
+ * second run with the input fed through a pipe, which is read in
+ * 64 KiB blocks instead. Both runs should print the same output.
+ * 
+ * usage: harness <results> <problem> <mode> <input> <ops> <cmd> [args...]
+ * 
+ * A tab-separated line is appended to `results`, and a readable
+ * one is printed to stdout. `ops` is the number of operations in
+ * the input (edges, queries, etc.), used to compute ops/sec.
+ * 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+// FNV-1a, good enough to tell outputs apart.
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Copy the file `in` into the pipe `fed`, from a child process.
+pid_t feed(int in, int fed[2]) {
+  pid_t pid = fork();
+  if (pid != 0) return pid;
+  close(fed[0]);
+  char buf[1<<16];
+  ssize_t n;
+  while ((n = read(in, buf, sizeof(buf))) > 0)
+    if (write(fed[1], buf, n) != n) break;
+  _exit(0);
+}
+
+// Run `cmd` with stdin from the file `in`, or through a pipe
+// if `piped`. The output is hashed into `hash`. Returns the
+// exit status, with the usage of the solver alone in `usage`.
+int run(char** cmd, int in, int piped, unsigned long long* hash, struct rusage* usage) {
+
+  // The feeder is forked before the output pipe is made,
+  // so it doesn't hold the output open.
+  int fed[2];
+  pid_t feeder = -1;
+  if (piped) {
+    if (pipe(fed) < 0) {
+      perror("pipe");
+      exit(1);
+    }
+    lseek(in, 0, SEEK_SET);
+    feeder = feed(in, fed);
+  }
+
+  // The solver writes to a pipe, which we drain and hash.
+  int out[2];
+  if (pipe(out) < 0) {
+    perror("pipe");
+    exit(1);
+  }
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    dup2(piped ? fed[0] : in, 0);
+    dup2(out[1], 1);
+    close(out[0]);
+    close(out[1]);
+    if (piped) close(fed[0]), close(fed[1]);
+    execv(cmd[0], cmd);
+    perror(cmd[0]);
+    _exit(127);
+  }
+  close(out[1]);
+  if (piped) close(fed[0]), close(fed[1]);
+
+  char buf[1<<16];
+  ssize_t n;
+  *hash = FNV_OFFSET;
+  while ((n = read(out[0], buf, sizeof(buf))) > 0)
+    for (ssize_t i = 0; i < n; i++)
+      *hash = (*hash ^ (unsigned char)buf[i]) * FNV_PRIME;
+  close(out[0]);
+
+  int status;
+  wait4(pid, &status, 0, usage);
+  if (feeder > 0) waitpid(feeder, NULL, 0);
+  return status;
+}
+
+int main(int argc, char** argv) {
+
+  if (argc < 7) {
+    fprintf(stderr, "usage: %s <results> <problem> <mode> <input> <ops> <cmd> [args...]\n", argv[0]);
+    return 1;
+  }
+  const char* results = argv[1];
+  const char* problem = argv[2];
+  const char* mode = argv[3];
+  const char* input = argv[4];
+  long long ops = atoll(argv[5]);
+
+  int in = open(input, O_RDONLY);
+  struct stat st;
+  if (in < 0 || fstat(in, &st) < 0) {
+    perror(input);
+    return 1;
+  }
+
+  // Time the solver on the file.
+  unsigned long long hash;
+  struct rusage usage;
+  double begin = now();
+  int status = run(argv+6, in, 0, &hash, &usage);
+  double wall = now() - begin;
+
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    fprintf(stderr, "[BENCH] %s %s exited abnormally (status %d)\n", problem, mode, status);
+
+  // Then measure its memory through a pipe.
+  unsigned long long piped_hash;
+  run(argv+6, in, 1, &piped_hash, &usage);
+  if (piped_hash != hash)
+    fprintf(stderr, "[BENCH] %s %s prints another output through a pipe\n", problem, mode);
+
+  double ops_per_sec = ops / wall;
+  double mb_per_sec = st.st_size / wall / 1e6;
+
+  printf("[BENCH] %-6s %-12s %8.3fs %8ld KiB %12.0f ops/s %8.2f MB/s  %016llx\n",
+    problem, mode, wall, usage.ru_maxrss, ops_per_sec, mb_per_sec, hash);
+
+  FILE* fp = fopen(results, "a");
+  if (!fp) {
+    perror(results);
+    return 1;
+  }
+  fprintf(fp, "%s\t%s\t%s\t%.6f\t%ld\t%lld\t%lld\t%.0f\t%.3f\t%016llx\n",
+    problem, mode, input, wall, usage.ru_maxrss, (long long)st.st_size,
+    ops, ops_per_sec, mb_per_sec, hash);
+  fclose(fp);
+
+  return 0;
+}
@@ -0,0 +1,214 @@
+/*
+ * Microbenchmark for the weighted uf-set component
+ *
+ * usage: micro-dsu [results] [n] [statements] [seed]
+ *
+ * Pass an empty `results` to print only.
+ *
+ * Compare lib/weighted_dsu.h against the hand-written uf-sets that
+ * POJ 1182 (modulo 3) and POJ 1417 (XOR) used to carry:
+ * 
+ * - baseline: the original ones, with a recursive find() that
+ *   compresses paths, and no union by size
+ * - hand: union by size with separate parent[], relation[] and
+ *   size[] arrays, and an iterative find()
+ * - template: lib/weighted_dsu.h
+ * 
+ * Each one checks `statements` random statements over `n` nodes like
+ * POJ 1182 does: a statement relating two nodes in the same set is
+ * checked, and otherwise it merges their sets. The hash is the number
+ * of false statements, so all variants of a group should agree.
+ */
+
+#include <stdlib.h>
+#include "micro.h"
+#include "../gen/rng.h"
+#include "../../src/lib/weighted_dsu.h"
+
+#define MAX_NODES (1 << 22)
+
+/*
+ * Hand-written uf-sets
+ */
+
+int parent[MAX_NODES];
+int relation[MAX_NODES];
+int set_size[MAX_NODES];
+
+// The original find(), with relations modulo `K`. The parent
+// of `x` is updated first, so its relation is to the root.
+int base_find(int x, int K) {
+  if (x == parent[x]) return x;
+  int px = parent[x];
+  parent[x] = base_find(px, K);
+  relation[x] = (relation[x] + relation[px]) % K;
+  return parent[x];
+}
+
+void hand_init(int n) {
+  for (int i = 0; i <= n; i++) {
+    parent[i] = i;
+    relation[i] = 0;
+    set_size[i] = 1;
+  }
+}
+
+int hand_find3(int x) {
+  int root = x, sum = 0;
+  while (root != parent[root]) {
+    sum += relation[root];
+    root = parent[root];
+  }
+  sum %= 3;
+
+  while (x != root) {
+    int px = parent[x];
+    int rx = relation[x];
+    parent[x] = root;
+    relation[x] = sum;
+    sum -= rx;
+    if (sum < 0) sum += 3;
+    x = px;
+  }
+  return root;
+}
+
+void hand_merge3(int a, int b, int r) {
+  if (set_size[a] < set_size[b]) {
+    parent[a] = b;
+    relation[a] = (3 - r) % 3;
+    set_size[b] += set_size[a];
+  } else {
+    parent[b] = a;
+    relation[b] = r;
+    set_size[a] += set_size[b];
+  }
+}
+
+int hand_find2(int x) {
+  int root = x, sum = 0;
+  while (root != parent[root]) {
+    sum ^= relation[root];
+    root = parent[root];
+  }
+
+  while (x != root) {
+    int px = parent[x];
+    int rx = relation[x];
+    parent[x] = root;
+    relation[x] = sum;
+    sum ^= rx;
+    x = px;
+  }
+  return root;
+}
+
+void hand_merge2(int a, int b, int r) {
+  if (set_size[a] < set_size[b]) {
+    int t = a; a = b; b = t;
+  }
+  parent[b] = a;
+  relation[b] = r;
+  set_size[a] += set_size[b];
+}
+
+/*
+ * Statements
+ */
+
+struct statement {
+  int x, y, r;
+};
+
+statement* statements;
+
+// Run all statements of relations modulo `K` on the original
+// uf-sets, return the number of false ones. Merges hang the set
+// of `y` under the set of `x`, whatever their sizes.
+long long run_baseline(int n, int k, int K) {
+  long long lies = 0;
+  hand_init(n);
+  for (int i = 0; i < k; i++) {
+    int x = statements[i].x, y = statements[i].y, r = statements[i].r;
+    int root_x = base_find(x, K), root_y = base_find(y, K);
+    if (root_x == root_y) {
+      lies += (relation[x] + r) % K != relation[y];
+    } else {
+      parent[root_y] = root_x;
+      relation[root_y] = (relation[x] - relation[y] + r + K) % K;
+    }
+  }
+  return lies;
+}
+
+// The same on the hand-written uf-sets with union by size.
+long long run_hand(int n, int k, int K) {
+  long long lies = 0;
+  hand_init(n);
+  for (int i = 0; i < k; i++) {
+    int x = statements[i].x, y = statements[i].y, r = statements[i].r;
+    if (K == 3) {
+      int root_x = hand_find3(x), root_y = hand_find3(y);
+      if (root_x == root_y) lies += (relation[x] + r) % 3 != relation[y];
+      else hand_merge3(root_x, root_y, (relation[x] - relation[y] + r + 3) % 3);
+    } else {
+      int root_x = hand_find2(x), root_y = hand_find2(y);
+      if (root_x == root_y) lies += (relation[x] ^ r) != relation[y];
+      else hand_merge2(root_x, root_y, relation[x] ^ relation[y] ^ r);
+    }
+  }
+  return lies;
+}
+
+// The same on lib/weighted_dsu.h.
+template <class Group>
+long long run_template(weighted_dsu<Group, MAX_NODES>& dsu, int n, int k) {
+  long long lies = 0;
+  dsu.init(n);
+  for (int i = 0; i < k; i++) {
+    int x = statements[i].x, y = statements[i].y, r = statements[i].r;
+    int root_x = dsu.find(x), root_y = dsu.find(y);
+    int rx = dsu.relation(x), ry = dsu.relation(y);
+    if (root_x == root_y) lies += Group::add(rx, r) != ry;
+    else dsu.merge(root_x, root_y, Group::add(Group::add(rx, Group::inverse(ry)), r));
+  }
+  return lies;
+}
+
+weighted_dsu<cyclic_group<3>, MAX_NODES> dsu3;
+weighted_dsu<xor_group, MAX_NODES> dsu2;
+
+int main(int argc, char** argv) {
+  const char* results = argc > 1 && argv[1][0] ? argv[1] : NULL;
+  int n = arg_or(argc, argv, 2, 65535);
+  int k = arg_or(argc, argv, 3, 10000000);
+  rng_seed(arg_or(argc, argv, 4, 1));
+  if (n >= MAX_NODES) n = MAX_NODES - 1;
+
+  char input[64];
+  statements = (statement*)malloc(sizeof(statement) * k);
+
+  for (int K = 3; K >= 2; K--) {
+    for (int i = 0; i < k; i++) {
+      statements[i].x = rng_range(1, n);
+      statements[i].y = rng_range(1, n);
+      statements[i].r = rng_range(0, K-1);
+    }
+    snprintf(input, sizeof(input), "%s-%d", K == 3 ? "mod3" : "xor", n);
+
+    double begin = now();
+    long long lies = run_baseline(n, k, K);
+    report(results, "dsu", "baseline", input, now() - begin, 0, k, lies);
+
+    begin = now();
+    lies = run_hand(n, k, K);
+    report(results, "dsu", "hand", input, now() - begin, 0, k, lies);
+
+    begin = now();
+    lies = K == 3 ? run_template(dsu3, n, k) : run_template(dsu2, n, k);
+    report(results, "dsu", "template", input, now() - begin, 0, k, lies);
+  }
+
+  free(statements);
+  return 0;
+}
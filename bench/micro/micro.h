@@ -0,0 +1,55 @@
+/*
+ * Helpers for microbenchmarks
+ * 
+ * Microbenchmarks time a single component in process, instead
+ * of running a whole solver under the harness. They report in
+ * the same format as the harness, so their lines could go to the
+ * same results file; `output_hash` is a hash of the result, to
+ * check that all variants agree.
+ */
+
+#ifndef MICRO_H
+#define MICRO_H
+
+#include <stdio.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static unsigned long long hash_ints(const int* a, long long n) {
+  unsigned long long hash = FNV_OFFSET;
+  for (long long i = 0; i < n; i++)
+    hash = (hash ^ (unsigned)a[i]) * FNV_PRIME;
+  return hash;
+}
+
+// Print a result line, and append it to `results` if it's not NULL.
+static void report(const char* results, const char* problem, const char* mode, const char* input,
+    double wall, long long bytes, long long ops, unsigned long long hash) {
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  printf("[BENCH] %-6s %-12s %-16s %8.3fs %8ld KiB %12.0f ops/s %8.2f MB/s  %016llx\n",
+    problem, mode, input, wall, usage.ru_maxrss, ops / wall, bytes / wall / 1e6, hash);
+
+  if (!results) return;
+  FILE* fp = fopen(results, "a");
+  if (!fp) {
+    perror(results);
+    return;
+  }
+  fprintf(fp, "%s\t%s\t%s\t%.6f\t%ld\t%lld\t%lld\t%.0f\t%.3f\t%016llx\n",
+    problem, mode, input, wall, usage.ru_maxrss, bytes, ops, ops / wall, bytes / wall / 1e6, hash);
+  fclose(fp);
+}
+
+#endif
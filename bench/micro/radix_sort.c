@@ -0,0 +1,132 @@
+/*
+ * Microbenchmark for the radix sort component
+ * 
+ * usage: micro-radix_sort [results] [scale] [seed]
+ * 
+ * Pass an empty `results` to print only.
+ * 
+ * Compare lib/radix_sort.c against qsort() on the sort steps of
+ * the solvers, `scale` times as large as their inputs:
+ * 
+ * - cows: 20000 cows of POJ 1990, keyed by thresholds in
+ *   [1, 20000], carrying their x axes
+ * - coords: 80000 x axises of POJ 3277 in [1, 1e9]
+ * - events: 80000 events of the 3277 sweep, keyed by x axis,
+ *   carrying heights
+ * 
+ * qsort() is not stable, so only keys are hashed.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "micro.h"
+#include "../gen/rng.h"
+#include "../../src/lib/radix_sort.h"
+
+#define MAX_COORD 1000000000
+
+int cmp_pair32(const void* a, const void* b) {
+  unsigned x = ((const struct radix_pair32*)a)->key, y = ((const struct radix_pair32*)b)->key;
+  return (x > y) - (x < y);
+}
+
+int cmp_u64(const void* a, const void* b) {
+  unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+  return (x > y) - (x < y);
+}
+
+int cmp_pair64(const void* a, const void* b) {
+  unsigned long long x = ((const struct radix_pair64*)a)->key, y = ((const struct radix_pair64*)b)->key;
+  return (x > y) - (x < y);
+}
+
+// Hash the keys of `n` items of `size` bytes, which start
+// with a key of `key_size` bytes.
+unsigned long long hash_keys(const void* items, int n, int size, int key_size) {
+  unsigned long long hash = FNV_OFFSET;
+  for (int i = 0; i < n; i++) {
+    unsigned long long key = 0;
+    memcpy(&key, (const char*)items + (long long)i * size, key_size);
+    hash = (hash ^ key) * FNV_PRIME;
+  }
+  return hash;
+}
+
+int main(int argc, char** argv) {
+  const char* results = argc > 1 && argv[1][0] ? argv[1] : NULL;
+  int scale = arg_or(argc, argv, 2, 1);
+  rng_seed(arg_or(argc, argv, 3, 1));
+
+  char input[64];
+  double begin;
+
+  // Cows
+  int n = 20000 * scale;
+  struct radix_pair32* cows = malloc(sizeof(*cows) * n);
+  struct radix_pair32* cows_sorted = malloc(sizeof(*cows) * n);
+  struct radix_pair32* cows_tmp = malloc(sizeof(*cows) * n);
+  for (int i = 0; i < n; i++) {
+    cows[i].key = rng_range(1, 20000);
+    cows[i].value = rng_range(1, 20000);
+  }
+  snprintf(input, sizeof(input), "cows-%d", n);
+
+  memcpy(cows_sorted, cows, sizeof(*cows) * n);
+  begin = now();
+  qsort(cows_sorted, n, sizeof(*cows), cmp_pair32);
+  report(results, "sort", "qsort", input, now() - begin, sizeof(*cows) * n, n,
+    hash_keys(cows_sorted, n, sizeof(*cows), sizeof(cows->key)));
+
+  memcpy(cows_sorted, cows, sizeof(*cows) * n);
+  begin = now();
+  radix_sort_pairs32(cows_sorted, cows_tmp, n);
+  report(results, "sort", "radix", input, now() - begin, sizeof(*cows) * n, n,
+    hash_keys(cows_sorted, n, sizeof(*cows), sizeof(cows->key)));
+
+  // Coords
+  n = 80000 * scale;
+  unsigned long long* coords = malloc(sizeof(*coords) * n);
+  unsigned long long* coords_sorted = malloc(sizeof(*coords) * n);
+  unsigned long long* coords_tmp = malloc(sizeof(*coords) * n);
+  for (int i = 0; i < n; i++) coords[i] = rng_range(1, MAX_COORD);
+  snprintf(input, sizeof(input), "coords-%d", n);
+
+  memcpy(coords_sorted, coords, sizeof(*coords) * n);
+  begin = now();
+  qsort(coords_sorted, n, sizeof(*coords), cmp_u64);
+  report(results, "sort", "qsort", input, now() - begin, sizeof(*coords) * n, n,
+    hash_keys(coords_sorted, n, sizeof(*coords), sizeof(*coords)));
+
+  memcpy(coords_sorted, coords, sizeof(*coords) * n);
+  begin = now();
+  radix_sort_u64(coords_sorted, coords_tmp, n);
+  report(results, "sort", "radix", input, now() - begin, sizeof(*coords) * n, n,
+    hash_keys(coords_sorted, n, sizeof(*coords), sizeof(*coords)));
+
+  // Events
+  struct radix_pair64* events = malloc(sizeof(*events) * n);
+  struct radix_pair64* events_sorted = malloc(sizeof(*events) * n);
+  struct radix_pair64* events_tmp = malloc(sizeof(*events) * n);
+  for (int i = 0; i < n; i++) {
+    events[i].key = coords[i];
+    events[i].value = rng_range(1, MAX_COORD) * (i % 2 ? -1 : 1);
+  }
+  snprintf(input, sizeof(input), "events-%d", n);
+
+  memcpy(events_sorted, events, sizeof(*events) * n);
+  begin = now();
+  qsort(events_sorted, n, sizeof(*events), cmp_pair64);
+  report(results, "sort", "qsort", input, now() - begin, sizeof(*events) * n, n,
+    hash_keys(events_sorted, n, sizeof(*events), sizeof(events->key)));
+
+  memcpy(events_sorted, events, sizeof(*events) * n);
+  begin = now();
+  radix_sort_pairs64(events_sorted, events_tmp, n);
+  report(results, "sort", "radix", input, now() - begin, sizeof(*events) * n, n,
+    hash_keys(events_sorted, n, sizeof(*events), sizeof(events->key)));
+
+  free(cows), free(cows_sorted), free(cows_tmp);
+  free(coords), free(coords_sorted), free(coords_tmp);
+  free(events), free(events_sorted), free(events_tmp);
+  return 0;
+}
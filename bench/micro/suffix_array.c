@@ -0,0 +1,172 @@
+/*
+ * Microbenchmark for the suffix array component
+ * 
+ * usage: micro-suffix_array [results] [len] [queries] [seed]
+ * 
+ * Pass an empty `results` to print only.
+ * 
+ * Compare SA-IS against prefix doubling, then time each phase of
+ * lib/suffix_array.c: the whole build (suffix[], rank[] and
+ * height[]) of the string as chars and as ints, Kasai's height[]
+ * alone, the sparse table, and `queries` random LCP queries. All
+ * of them run on four kinds of strings of length `len`:
+ * 
+ * - random: uniform over 26 letters
+ * - periodic: "aaaa...", the worst case of doubling, which needs
+ *   log(len) rounds
+ * - dna: 4 letters, mostly made of mutated copies of earlier
+ *   segments, like a genome with repeats
+ * - repeat: a random block of 4 letters repeated over and over,
+ *   with rare point mutations, so most common prefixes run long
+ * 
+ * The height[] phase is named after how Kasai runs, which depends
+ * on the flags this is built with: the vector compare if any, and
+ * whether it prefetches. micro-suffix_array-plain is built with
+ * -DSA_NO_SIMD -DSA_PREFETCH=0 to compare against.
+ * 
+ * Doubling is skipped beyond DOUBLING_MAX_LEN, where it takes tens
+ * of seconds per string.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "micro.h"
+#include "../gen/rng.h"
+#include "../../src/lib/suffix_array.h"
+
+#if defined(SA_NO_SIMD) || !defined(__SSE2__)
+#define HEIGHT_COMPARE "height-scalar"
+#elif defined(__AVX2__)
+#define HEIGHT_COMPARE "height-avx2"
+#else
+#define HEIGHT_COMPARE "height-sse2"
+#endif
+
+#if defined(SA_PREFETCH) && !SA_PREFETCH
+#define HEIGHT_MODE HEIGHT_COMPARE
+#else
+#define HEIGHT_MODE HEIGHT_COMPARE "+prefetch"
+#endif
+
+#define DOUBLING_MAX_LEN 4000000
+
+// Fill str[0..len-1) with a string of `kind`, and end it with 0.
+// Return the range of chars.
+int make_string(const char* kind, char* str, int len) {
+  int n = len - 1;
+
+  if (!strcmp(kind, "periodic")) {
+    memset(str, 1, n);
+
+  } else if (!strcmp(kind, "dna")) {
+    int i = 0;
+    while (i < n) {
+      int seg = rng_range(100, 5000);
+      if (seg > n - i) seg = n - i;
+
+      // Copy an earlier segment with ~1% point mutations,
+      // or write a fresh random one.
+      if (i > seg && rng_range(0, 3)) {
+        int from = rng_range(0, i - seg);
+        for (int j = 0; j < seg; j++)
+          str[i+j] = rng_range(0, 99) ? str[from+j] : 1 + rng_range(0, 3);
+      } else {
+        for (int j = 0; j < seg; j++) str[i+j] = 1 + rng_range(0, 3);
+      }
+      i += seg;
+    }
+    str[n] = 0;
+    return 5;
+
+  } else if (!strcmp(kind, "repeat")) {
+    int block = 1000;
+    for (int i = 0; i < n; i++) {
+      if (i < block) str[i] = 1 + rng_range(0, 3);
+      else str[i] = rng_range(0, 9999) ? str[i-block] : 1 + rng_range(0, 3);
+    }
+    str[n] = 0;
+    return 5;
+
+  } else {
+    for (int i = 0; i < n; i++) str[i] = 1 + rng_range(0, 25);
+  }
+
+  str[n] = 0;
+  return 27;
+}
+
+// Hash the sparse table level by level. Level `k` only holds
+// len - 2^k + 1 entries, the rest of it is never written.
+unsigned long long hash_rmq(const int* table, int len, int levels) {
+  unsigned long long hash = FNV_OFFSET;
+  for (int k = 0; k < levels; k++)
+    for (int i = 0; i + (1 << k) <= len; i++)
+      hash = (hash ^ (unsigned)table[k*len + i]) * FNV_PRIME;
+  return hash;
+}
+
+int main(int argc, char** argv) {
+  const char* results = argc > 1 && argv[1][0] ? argv[1] : NULL;
+  int len = arg_or(argc, argv, 2, 200000);
+  int queries = arg_or(argc, argv, 3, 1000000);
+  rng_seed(arg_or(argc, argv, 4, 1));
+
+  const char* kinds[] = {"random", "periodic", "dna", "repeat"};
+  char* str = malloc(len);
+  int* str_int = malloc(sizeof(int)*len);
+  int* suffix = malloc(sizeof(int)*len);
+
+  struct suffix_array sa;
+  sa_init(&sa, malloc(sizeof(int)*len), malloc(sizeof(int)*len), malloc(sizeof(int)*(len+1)), len);
+  int* table = malloc(sizeof(int)*sa_rmq_size(len));
+  int* answers = malloc(sizeof(int)*queries);
+
+  for (int k = 0; k < 4; k++) {
+    int range = make_string(kinds[k], str, len);
+    char input[64];
+    snprintf(input, sizeof(input), "%s-%d", kinds[k], len);
+
+    double begin;
+    if (len <= DOUBLING_MAX_LEN) {
+      begin = now();
+      sa_build_doubling(str, len, range, suffix);
+      report(results, "sa", "doubling", input, now() - begin, len, len, hash_ints(suffix, len));
+    }
+
+    begin = now();
+    sa_build_sais(str, len, range, suffix);
+    report(results, "sa", "sais", input, now() - begin, len, len, hash_ints(suffix, len));
+
+    begin = now();
+    sa_build(&sa, str, len, range);
+    report(results, "sa", "build+lcp", input, now() - begin, len, len, hash_ints(sa.height, len));
+
+    for (int i = 0; i < len; i++) str_int[i] = str[i];
+    begin = now();
+    sa_build_int(&sa, str_int, len, range);
+    report(results, "sa", "build+lcp-int", input, now() - begin, len, len, hash_ints(sa.height, len));
+
+    begin = now();
+    sa_build_height(&sa, str);
+    report(results, "sa", HEIGHT_MODE, input, now() - begin, len, len, hash_ints(sa.height, len));
+
+    begin = now();
+    sa_build_rmq(&sa, table);
+    report(results, "sa", "rmq", input, now() - begin, len, len, hash_rmq(table, len, sa.levels));
+
+    begin = now();
+    for (int i = 0; i < queries; i++)
+      answers[i] = sa_lcp(&sa, rng_range(0, len-1), rng_range(0, len-1));
+    report(results, "sa", "lcp-query", input, now() - begin, 0, queries, hash_ints(answers, queries));
+  }
+
+  free(str);
+  free(str_int);
+  free(suffix);
+  free(sa.suffix);
+  free(sa.rank);
+  free(sa.height);
+  free(table);
+  free(answers);
+  return 0;
+}
@@ -0,0 +1,245 @@
+#!/bin/sh
+#
+# Benchmark all solvers on generated inputs.
+#
+# usage: bench/run.sh [problem...]
+#
+# A problem is one of the solvers in src/, or a microbenchmark
+# (sa for suffix array builders, sort for radix sort, dsu for
+# weighted uf-sets).
+#
+# Inputs are generated into bench/data at the maximum sizes allowed
+# by the constants in src/, and regenerated only if the generator
+# changes. Results are appended to bench/results.tsv (or $RESULTS),
+# one line per run:
+#
+#   problem mode input wall_s peak_rss_kb input_bytes ops ops_per_s mb_per_s output_hash
+#
+# `ops` counts the items a solver has to process (edges, statements,
+# queries...), see each section below. Runs of different modes on
+# the same input should have the same output_hash.
+#
+
+set -e
+
+BIN=bench/bin
+DATA=bench/data
+RESULTS=${RESULTS:-bench/results.tsv}
+
+# Degenerate trees (chains and caterpillars) run with this stack
+# limit in KiB, far below the depth of the trees, to show that
+# the DFS in tree solvers does not recurse.
+STRESS_STACK=256
+SELECTED="$*"
+
+mkdir -p $DATA
+# Keep the results of earlier runs, and write the header only
+# into a new file.
+if [ ! -s $RESULTS ]; then
+  printf 'problem\tmode\tinput\twall_s\tpeak_rss_kb\tinput_bytes\tops\tops_per_s\tmb_per_s\toutput_hash\n' > $RESULTS
+fi
+
+# want <problem>: whether <problem> is selected on the command line.
+want() {
+  [ -z "$SELECTED" ] && return 0
+  case " $SELECTED " in *" $1 "*) return 0 ;; esac
+  return 1
+}
+
+# gen <file> <generator> [args...]: generate $DATA/<file> if it is
+# missing or older than its generator.
+gen() {
+  file=$DATA/$1
+  shift
+  if [ ! -f $file ] || [ $BIN/$1 -nt $file ]; then
+    $BIN/"$@" > $file
+  fi
+}
+
+# run <problem> <mode> <file> <ops> <binary> [args...]
+run() {
+  local problem=$1 mode=$2 file=$3 ops=$4
+  shift 4
+  $BIN/harness $RESULTS $problem $mode $DATA/$file $ops "$@"
+}
+
+# ops: statements
+if want 1182; then
+  gen 1182.txt gen-1182 65535 100000
+  gen 1182-chain.txt gen-1182 65535 10000000 1182 chain
+  run 1182 default 1182.txt 100000 bin/1182
+  (ulimit -s $STRESS_STACK; run 1182 default 1182-chain.txt 10000000 bin/1182)
+fi
+
+# ops: test cases
+if want 1275; then
+  gen 1275.txt gen-1275 100 1000
+  gen 1275-small.txt gen-1275 10000 10
+  gen 1275-100k.txt gen-1275 100000 100
+  for mode in incremental scan rebuild; do
+    run 1275 $mode 1275.txt 100 bin/1275 $mode
+    run 1275 $mode 1275-small.txt 10000 bin/1275 $mode
+    run 1275 $mode 1275-100k.txt 100000 bin/1275 $mode
+  done
+fi
+
+# ops: statements over all cases
+if want 1417; then
+  gen 1417.txt gen-1417 100 1000 299 299
+  gen 1417-10k.txt gen-1417 10000 300 299 299
+  gen 1417-small.txt gen-1417 10000 10 5 5
+  run 1417 default 1417.txt 100000 bin/1417
+  run 1417 default 1417-10k.txt 3000000 bin/1417
+  run 1417 default 1417-small.txt 100000 bin/1417
+fi
+
+# ops: nodes + queries over all cases
+if want 1470; then
+  gen 1470.txt gen-1470 10 999 100000
+  gen 1470-small.txt gen-1470 10000 10 10
+  run 1470 default 1470.txt 1009990 bin/1470
+  run 1470 default 1470-small.txt 200000 bin/1470
+  for shape in chain caterpillar; do
+    gen 1470-$shape.txt gen-1470 10 999 100000 $shape
+    (ulimit -s $STRESS_STACK; run 1470 default 1470-$shape.txt 1009990 bin/1470)
+  done
+fi
+
+# ops: roads + queries
+if want 1986; then
+  gen 1986.txt gen-1986 40000 10000
+  gen 1986-1m.txt gen-1986 40000 1000000
+  gen 1986-small.txt gen-1986 20 10 random 1986 10000
+  for mode in euler tarjan; do
+    run 1986 $mode 1986.txt 49999 bin/1986 $mode
+    run 1986 $mode 1986-1m.txt 1039999 bin/1986 $mode
+    run 1986 $mode 1986-small.txt 290000 bin/1986 $mode
+  done
+  for shape in chain caterpillar; do
+    gen 1986-$shape.txt gen-1986 40000 10000 $shape
+    for mode in euler tarjan; do
+      (ulimit -s $STRESS_STACK; run 1986 $mode 1986-$shape.txt 49999 bin/1986 $mode)
+    done
+  done
+fi
+
+# ops: cows
+if want 1990; then
+  gen 1990.txt gen-1990 20000 20000
+  gen 1990-10m.txt gen-1990 10000000 1000000000
+  run 1990 default 1990.txt 20000 bin/1990
+  run 1990 default 1990-10m.txt 10000000 bin/1990
+
+  # Scaling of the cdq engine over threads, up to the cores online.
+  cores=$(getconf _NPROCESSORS_ONLN)
+  threads=1
+  while :; do
+    run 1990 cdq-$threads 1990.txt 20000 bin/1990 cdq $threads
+    run 1990 cdq-$threads 1990-10m.txt 10000000 bin/1990 cdq $threads
+    [ $threads -ge $cores ] && break
+    threads=$((threads * 2))
+    [ $threads -gt $cores ] && threads=$cores
+  done
+fi
+
+# ops: operations
+if want 2777; then
+  gen 2777.txt gen-2777 100000 30 100000
+  gen 2777-64.txt gen-2777 100000 64 100000
+  gen 2777-256.txt gen-2777 100000 256 100000
+
+  # bin/2777 holds up to 64 colors, bench/bin/2777-256 up to 256.
+  for mode in iterative recursive; do
+    run 2777 $mode 2777.txt 100000 bin/2777 $mode
+    run 2777 $mode 2777-64.txt 100000 bin/2777 $mode
+    for input in 2777.txt 2777-64.txt 2777-256.txt; do
+      run 2777 $mode-256 $input 100000 $BIN/2777-256 $mode
+    done
+  done
+fi
+
+# ops: constraints
+if want 3159; then
+  gen 3159.txt gen-3159 30000 150000 10000
+  for mode in spfa-stack spfa-queue heap radix bellman-ford; do
+    run 3159 $mode 3159.txt 150000 bin/3159 $mode
+  done
+
+  # Negative weights: only the Bellman-Ford engines apply. The
+  # first input is still feasible, the second has negative cycles.
+  gen 3159-neg.txt gen-3159 30000 150000 10000 3159 -100
+  gen 3159-cycle.txt gen-3159 10000 50000 10000 3159 -500
+  for mode in spfa-queue bellman-ford; do
+    run 3159 $mode 3159-neg.txt 150000 bin/3159 $mode
+    run 3159 $mode 3159-cycle.txt 50000 bin/3159 $mode
+  done
+fi
+
+# ops: buildings
+if want 3277; then
+  gen 3277.txt gen-3277 49999
+  gen 3277-1m.txt gen-3277 1000000
+  gen 3277-4m.txt gen-3277 4000000
+
+  for mode in sweep tree; do
+    run 3277 $mode 3277.txt 49999 bin/3277 $mode
+    run 3277 $mode 3277-1m.txt 1000000 $BIN/3277-1m $mode
+  done
+
+  # Beyond the tree engine.
+  run 3277 sweep 3277-4m.txt 4000000 bin/3277 sweep
+fi
+
+# ops: characters over all cases
+if want 3294; then
+  gen 3294.txt gen-3294 3 100 1000 4
+  gen 3294-5k.txt gen-3294 1 5000 200 4
+  gen 3294-long.txt gen-3294 1 3 2000000 4
+  run 3294 default 3294.txt 300000 bin/3294
+  run 3294 default 3294-5k.txt 1000000 bin/3294
+  run 3294 default 3294-long.txt 6000000 bin/3294
+fi
+
+# ops: forks + operations
+if want 3321; then
+  gen 3321.txt gen-3321 100000 100000
+  gen 3321-10m.txt gen-3321 100000 10000000
+  gen 3321-10m-burst.txt gen-3321 100000 10000000 random 3321 64
+  for mode in batch single; do
+    run 3321 $mode 3321.txt 199999 bin/3321 $mode
+    run 3321 $mode 3321-10m.txt 10099999 bin/3321 $mode
+    run 3321 $mode 3321-10m-burst.txt 10099999 bin/3321 $mode
+  done
+  for shape in chain caterpillar; do
+    gen 3321-$shape.txt gen-3321 100000 100000 $shape
+    (ulimit -s $STRESS_STACK; run 3321 default 3321-$shape.txt 199999 bin/3321)
+  done
+fi
+
+# ops: characters
+if want 3415; then
+  gen 3415.txt gen-3415 1 99999 1 2
+  run 3415 default 3415.txt 199998 bin/3415
+fi
+
+# Microbenchmarks, see bench/micro
+
+# ops: characters
+if want sa; then
+  for len in 200000 2000000 20000000; do
+    $BIN/micro-suffix_array $RESULTS $len
+    $BIN/micro-suffix_array-plain $RESULTS $len
+  done
+fi
+
+# ops: statements
+if want dsu; then
+  $BIN/micro-dsu $RESULTS 65535
+  $BIN/micro-dsu $RESULTS 4000000
+fi
+
+# ops: items sorted
+if want sort; then
+  $BIN/micro-radix_sort $RESULTS 1
+  $BIN/micro-radix_sort $RESULTS 10
+fi
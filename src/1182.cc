@@ -0,0 +1,103 @@
+#include <cstdio>
+
+#include "lib/fastio.h"
+#include "lib/weighted_dsu.h"
+
+#define MAXARRAY 65536
+
+// Possible relations
+enum relation {
+  SAME, // same species
+  PREDATE, // a is the predator of b
+  EATENBY, // b is the predator of a
+};
+
+// Possible operations
+enum operations {
+  IN_SAME_SPECIES = 1,
+  IS_PREDATOR = 2,
+};
+
+/*
+ * We put all objects with certain relationship in an uf-set,
+ * so there will be an uf-set for each group.
+ *
+ * Each animal also keeps its relation with the root of its
+ * uf-set. Relations are arithmatic modulo 3: if the relation
+ * of `x` with the root is r_x and the relation of `y` is r_y,
+ * x & y are the same species if r_x == r_y, and x is the
+ * predator of y if r_x + 1 == r_y. The relation with the root
+ * is the sum along the path to it, which lib/weighted_dsu.h
+ * keeps up to date on each find().
+ */
+
+weighted_dsu<cyclic_group<3>, MAXARRAY> uf_set;
+
+// a is the predator of b
+int is_predator(int a, int b) {
+  return (uf_set.relation(a) + 1) % 3 == uf_set.relation(b);
+}
+
+int main() {
+
+  int N, K; // N animals, K statements
+  read_int(&N), read_int(&K);
+
+  // Init all uf-sets and relations
+  uf_set.init(N);
+
+  int lie_times = 0;
+  int ope, x, y;
+
+  // Read all statements and discern the occurence of lies.
+  for (int i = 0; i < K; i++) {
+    read_int(&ope), read_int(&x), read_int(&y);
+
+    // Out of range
+    if (x > N || y > N) {
+      lie_times++;
+      continue;
+    }
+
+    // Self-predator
+    if (ope == IS_PREDATOR && x == y) {
+      lie_times++;
+      continue;
+    }
+
+    int root_x = uf_set.find(x);
+    int root_y = uf_set.find(y);
+
+    // If x & y's relationship is certain, we could
+    // discern the facticity of this statement rightaway.
+    if (root_x == root_y) {
+      if (ope == IN_SAME_SPECIES && uf_set.relation(x) != uf_set.relation(y))
+        lie_times++;
+      if (ope == IS_PREDATOR && !is_predator(x, y))
+        lie_times++;
+
+    // Elsewise, assume that the statement is true.
+    } else {
+      // Since we're going to hang root_y under root_x (or the
+      // other way around), we need their relation.
+      //
+      // But how? Firstly, root_x and root_y's relation can be
+      // represented by relation(x, y) & relation(x, root_x) & relation(y, root_y).
+      //
+      // relation(x, y) = ope - 1, since the statement is true.
+      // relation(x, root_x) = uf_set.relation(x)
+      // relation(y, root_y) = uf_set.relation(y)
+      // SO we can come up with a formula to calculate the relation of root_y with root_x.
+      //
+      // Another WA here: do not write ope-1 straightaway, use ope+2 instead.
+      //
+      // We modify the relation of the children in
+      // the next find() operation.
+      uf_set.merge(root_x, root_y, (uf_set.relation(x) - uf_set.relation(y) + ope + 2) % 3);
+
+    }
+  }
+
+  printf("%d\n", lie_times);
+  return 0;
+}
\ No newline at end of file
@@ -26,14 +26,18 @@
  * - sum[i] + sum[23] - sum[i+16] >= required[i] (i <= 8)
  * - sum[i] - sum[i-8] >= required[i] (i > 8)
  * 
- * Transform them into standard form, and use SPFA to obtain
- * the longest path.
+ * Transform them into standard form, and use Bellman-Ford to
+ * obtain the longest path.
  * 
  */
  
 #include <stdio.h>
 #include <string.h>
 
+#include "lib/fastio.h"
+#include "lib/bellman_ford.h"
+#include "lib/csr.h"
+
 #define MAX_N 1001
 #define MAX_E 1001
 
@@ -56,6 +60,7 @@ int head[MAX_N];
 // Each vertex in head[] points to an edge list in edges[],
 // which is linked by `next` attribute.
 struct {
+  int from; // the source of this edge
   int to; // the destination of this edge
   int weight; // the weight of this edge
   int next; // next edge in the linked list
@@ -68,147 +73,255 @@ void add_edge(int from, int to, int weight) {
 
   // Add to the head of related linked list
   edges[num_edges].next = head[from];
+  edges[num_edges].from = from;
   edges[num_edges].to = to;
   edges[num_edges].weight = weight;
 
   head[from] = num_edges++;
 }
 
-// Clear the graph
-void init_graph() {
+// Clear the graph of vertices [0, n].
+//
+// add_edge() sets every field of a new edge, so
+// only the vertices need to be cleared.
+void init_graph(int n) {
   num_edges = 0;
-  memset(head, END, sizeof(head));
-  memset(edges, 0, sizeof(edges));
+  memset(head, END, sizeof(int)*(n+1));
 }
 
 /*
- * SPFA APIs
+ * Frozen graph APIs
+ * 
+ * Once all edges are added, the graph is frozen into compressed
+ * sparse rows, see lib/csr.h.
+ * 
+ * The linked lists are left untouched, so add_edge() and head[]
+ * still work after freezing.
  */
 
-#define INF 0x3f3f3f3f
+// offsets[i]: the first out-edge of vertex `i` in targets[].
+int offsets[MAX_N+2];
+// The destination and weight of each edge, sorted by source.
+int targets[MAX_E];
+int weights[MAX_E];
 
-// Use queue as memory
-int queue[MAX_N];
-int visited[MAX_N];
-int q_head;
-int q_tail;
+// Store an edge into slot `pos` of targets[] and weights[].
+#define PUT_EDGE(pos, edge) \
+  (targets[pos] = (edge).to, weights[pos] = (edge).weight)
 
-// DP memory
-int distance[MAX_N];
+// freeze_graph(n, m): build offsets[], targets[] and weights[]
+// from edges[0..m). Vertices should be in range [0, n].
+DEFINE_CSR_FREEZE(freeze_graph, edges, from, offsets, PUT_EDGE)
 
-// SPFA algo to obtain the longest path.
-int SPFA(int start, int n) {
-  q_head = q_tail = 0;
-
-  // Record how many times each vertex's distance
-  // has been updated too avoid infinite loop.
-  int cnt[MAX_N];
-
-  // init the queue
-  for (int i = 0; i <= n; i++) {
-    if (i == start) {
-      queue[q_head] = i;
-      q_head = (q_head+1) % MAX_N;
-      visited[i] = 1;
-      distance[i] = 0;
-    } else {
-      visited[i] = 0;
-      distance[i] = -INF;
-    }
-    cnt[i] = 0;
-  }  
-
-  // DP with a loop
-  while (q_head != q_tail) {
-
-    // Pick a vertex out of queue
-    int from = queue[q_tail];
-    q_tail = (q_tail+1) % MAX_N;
-    visited[from] = 0;
-
-    // For each edge starts from this vertex, 
-    // update its distance. If a vertex's distance
-    // is updated, push it back to queue.
-    for (int i = head[from]; i != END; i = edges[i].next) {
-      int to = edges[i].to;
-      if (distance[to] < distance[from] + edges[i].weight) {
-        distance[to] = distance[from] + edges[i].weight;
-        if (!visited[to]) {
-          visited[to] = 1;
-          queue[q_head] = to;
-          q_head = (q_head + 1) % MAX_N;
-        }
+/*
+ * Bellman-Ford APIs
+ * 
+ * lib/bellman_ford.h finds shortest paths, so the constraints are
+ * laid out on -sum[]: `sum[b] >= sum[a] + w` turns into an edge
+ * a -> b weighing -w, and distance[i] is -sum[i]. A positive cycle
+ * of the longest paths is a negative one here, and it's caught as
+ * soon as it shows up instead of after 24 updates of a vertex.
+ */
 
-        // Avoid the infinite loop
-        if (++cnt[to] > n) return 0;
-      }
-    }
-  }
+#define INF BF_INF
 
-  return 1;
+struct bellman_ford bf;
+int bf_work[BF_WORK_SIZE(24)];
+
+// DP memory
+int distance[MAX_N];
+
+// Find shortest paths from `start` from scratch. Return
+// 0 on a negative cycle.
+int solve(int start) {
+  bf_clear(&bf);
+  bf_root(&bf, start, 0, 1);
+  return bf_run(&bf);
 }
 
 /*
  * Related to problem
  */
 
+// Engines
+enum engine {
+  INCREMENTAL,
+  SCAN,
+  REBUILD,
+};
+
 int required[MAX_N];
 int applicants[MAX_N];
 
-int main() {
+// Build and freeze the graph for sum[24] = mid.
+void build_graph(int mid) {
+
+  // Don't forget to clean the graph
+  init_graph(24);
+
+  // For constraints without limited range of i,
+  // add an edge for each time slot.
+  for (int i = 1; i <= 24; i++) {
+    add_edge(i-1, i, 0);
+    add_edge(i, i-1, applicants[i]);
+  }
+
+  // For constraints with limited i, only add edges
+  // for proper time slots.
+  for (int i = 1; i <= 8; i++) add_edge(i+16, i, mid - required[i]);
+  for (int i = 9; i <= 24; i++) add_edge(i-8, i, -required[i]);
+
+  // A proper sum[23] must satisfy this.
+  add_edge(0, 24, -mid);
+
+  // Lay out the edges for Bellman-Ford.
+  freeze_graph(24, num_edges);
+}
+
+/*
+ * Incremental solving
+ *
+ * Only 9 edges depend on mid: (i+16) -> i for i in [1, 8] and
+ * 0 -> 24. So the graph is built once per case, and each mid
+ * only patches their weights in place.
+ *
+ * Bellman-Ford could also start from the distances of an earlier
+ * mid instead of INF, as long as they are still lengths of some
+ * paths from 0: relaxing never pushes them below the shortest
+ * ones, and stops only when all edges hold. Lowering mid by
+ * `delta` lowers the 8 edges and raises 0 -> 24 by `delta`. A
+ * shortest path from 0 is simple when there's no negative cycle,
+ * so it takes 0 -> 24 at most once, and every old distance plus
+ * `delta` is still long enough.
+ *
+ * Both searches only ever go below the last proper mid, so each
+ * run after the first proper one starts from its distances, with
+ * each vertex as a root of its own. The shift keeps all edges
+ * holding except the ones leaving 0, whose distance stays 0, and
+ * the 8 lowered ones, so only their sources are queued.
+ */
+
+// mid_slots[i]: the CSR slot of edge (i+16) -> i, and
+// mid_slots[0] is the slot of edge 0 -> 24.
+int mid_slots[9];
+
+// Distances of the last proper mid, and that mid.
+int proper[MAX_N];
+int proper_mid;
+
+// Find the CSR slot of edge `from` -> `to`.
+int find_slot(int from, int to) {
+  int i = offsets[from];
+  while (targets[i] != to) i++;
+  return i;
+}
+
+// Patch the weights depending on mid.
+void set_mid(int mid) {
+  for (int i = 1; i <= 8; i++) weights[mid_slots[i]] = mid - required[i];
+  weights[mid_slots[0]] = -mid;
+}
+
+// Test whether sum[24] could be `mid`, which should be lower
+// than `proper_mid` if there's one.
+int try_mid(int mid) {
+  set_mid(mid);
+
+  int feasible;
+  if (proper_mid < 0) feasible = solve(0);
+  else {
+    int delta = proper_mid - mid;
+    bf_clear(&bf);
+    bf_root(&bf, 0, 0, 1);
+    for (int i = 1; i <= 24; i++) bf_root(&bf, i, proper[i] + delta, i >= 17);
+    feasible = bf_run(&bf);
+  }
+
+  if (!feasible || distance[24] != -mid) return 0;
+  memcpy(proper, distance, sizeof(int)*(24+1));
+  proper_mid = mid;
+  return 1;
+}
+
+int main(int argc, char** argv) {
+
+  // Pick the engine
+  int mode = INCREMENTAL;
+  if (argc > 1) {
+    if (!strcmp(argv[1], "incremental")) mode = INCREMENTAL;
+    else if (!strcmp(argv[1], "scan")) mode = SCAN;
+    else if (!strcmp(argv[1], "rebuild")) mode = REBUILD;
+    else {
+      fprintf(stderr, "usage: %s [incremental|scan|rebuild]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  // The graph always has vertices [0, 24].
+  bf_init(&bf, 24, offsets, targets, weights, distance, bf_work);
 
   int N, M;
 
   // There will be N testcases
-  scanf("%d", &N);
+  read_int(&N);
   for (int i = 0; i < N; i++) {
 
     // At first we don't have any applicants
-    memset(applicants, 0, sizeof(applicants));
+    memset(applicants, 0, sizeof(int)*(24+1));
 
     // Get inputted data
     for (int i = 1; i <= 24; i++)
-      scanf("%d", &required[i]);
-    scanf("%d\n", &M);
+      read_int(&required[i]);
+    read_int(&M);
     for (int i = 0; i < M; i++) {
       int time;
-      scanf("%d", &time);
+      read_int(&time);
       applicants[time+1]++;
     }
 
-    // Run binary search on sum[23], try
-    // each possible sum[23] until we find
-    // a proper one.
-    int l = 0, r = M+1, ans = INF;
-    while (l <= r) {
-
-      // mid is the expected value of sum[23]
-      int mid = (l+r)/2;
-
-      // Don't forget to clean the graph
-      init_graph();
-
-      // For constraints without limited range of i,
-      // add an edge for each time slot.
-      for (int i = 1; i <= 24; i++) {
-        add_edge(i-1, i, 0);
-        add_edge(i, i-1, -applicants[i]);
+    int ans = INF;
+    if (mode == REBUILD) {
+
+      // Run binary search on sum[23], try
+      // each possible sum[23] until we find
+      // a proper one.
+      int l = 0, r = M+1;
+      while (l <= r) {
+
+        // mid is the expected value of sum[23]
+        int mid = (l+r)/2;
+        build_graph(mid);
+
+        // Run Bellman-Ford, if this mid is proper, store
+        // its value and shrink the range.
+        if (solve(0) && distance[24] == -mid) {
+          ans = mid;
+          r = mid-1;
+        } else l = mid+1;
       }
+    } else {
+      build_graph(0);
+      for (int i = 1; i <= 8; i++) mid_slots[i] = find_slot(i+16, i);
+      mid_slots[0] = find_slot(0, 24);
+      proper_mid = -1;
+
+      if (mode == INCREMENTAL) {
+
+        // The same binary search, on the patched graph.
+        int l = 0, r = M;
+        while (l <= r) {
+          int mid = (l+r)/2;
+          if (try_mid(mid)) {
+            ans = mid;
+            r = mid-1;
+          } else l = mid+1;
+        }
+      } else {
 
-      // For constraints with limited i, only add edges
-      // for proper time slots.
-      for (int i = 1; i <= 8; i++) add_edge(i+16, i, required[i] - mid);
-      for (int i = 9; i <= 24; i++) add_edge(i-8, i, required[i]);
-
-      // A proper sum[23] must satisfy this.
-      add_edge(0, 24, mid);
-
-      // Run SPFA, if this mid is proper, store its value
-      // and shrink the range.
-      if (SPFA(0, 24) && distance[24] == mid) {
-        ans = mid;
-        r = mid-1;
-      } else l = mid+1;
+        // Walk mid down from M, each run starting from the
+        // last one, until it's no longer proper.
+        for (int mid = M; mid >= 0 && try_mid(mid); mid--) ans = mid;
+      }
     }
 
     // ans > M indicates that the binary search
@@ -218,4 +331,4 @@ int main() {
   }
 
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,217 @@
+/*
+ * POJ 1417 True Liars
+ * 
+ * It could be derived that each statement determines a certain
+ * relationship between two people:
+ * 
+ * - a says that b is divine: a & b are in the same state (devine or not)
+ * - a says that b is not divine: a & b are in different states
+ * 
+ * So it's possible to store each group of people whose relationship
+ * could be determined into an uf-set, and use an extra array to mark
+ * the relationship between `x` and its root in uf-set, just like we
+ * did in POJ 1182.
+ * 
+ * After partitioning people into several uf-sets, we now have 2*`n`
+ * groups of people (`n` is the number of uf-sets): for each uf-set,
+ * we could divide it to 2 groups of people considering divinity, but
+ * we do *not* know which group is divine and which group is not.
+ * 
+ * uf-set                     :   1    2    3    4  ...  n
+ * number of people in group 0:  a_1  a_2  a_3  a_4 ... a_n
+ * number of people in group 1:  b_1  b_2  b_3  b_4 ... b_n
+ * 
+ * Then the problem is about if we could come up with an *unique* plan
+ * to pick a group in each uf-set, making the number of people in total
+ * equal to `p1`. e.g. a_1 + b_2 + b_3 + .... + a_n = p1.
+ * 
+ * Bruteforce would be an exponential algo here, so we use DP to
+ * reduce the complexity to polynomial. It works like a knapsack problem.
+ * 
+ * We only care whether the number of plans is 0, 1 or more, so the
+ * counts saturate at 2, and are kept as two bitsets over the number
+ * of people: `reachable` (at least 1 plan) and `multiple` (at least 2
+ * plans). Picking a group of `a` people shifts a bitset left by `a`,
+ * so each uf-set is a few shifts and ORs over 5 words, instead of a
+ * row of 300 counts:
+ * 
+ *   reachable' = (reachable << a) | (reachable << b)
+ *   multiple'  = (multiple << a) | (multiple << b)
+ *              | ((reachable << a) & (reachable << b))
+ * 
+ * Only `reachable` of each step is kept for tracing back, since along
+ * the unique plan exactly one of the two groups leads to a reachable
+ * state before it.
+ *   
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "lib/fastio.h"
+#include "lib/weighted_dsu.h"
+
+#define MAX_N 1000
+#define MAX_PEOPLE 300
+
+// Words of a bitset over [0, MAX_PEOPLE].
+#define WORDS (MAX_PEOPLE/64 + 1)
+
+// Possible relations
+enum relation {
+  SAME = 0, // same group
+  DIFF, // different group
+};
+
+/*
+ * We put all objects with certain relationship in an uf-set,
+ * so there will be an uf-set for each group.
+ */
+
+// The relation of each person with the root of their
+// uf-set, same group or not, adds by XOR.
+weighted_dsu<xor_group, MAX_N> uf_set;
+
+// The number of discerned groups
+int uf_set_num = 0;
+// uf_sets[i][SAME|DIFF] represents the number
+// of two groups of people in the `i`th uf-set.
+int uf_sets[MAX_N][2];
+// uf_set_in[i] is the serial of uf-set which `i` locates.
+int uf_set_in[MAX_N];
+
+// Bit `j` of reachable[i] is set if there is a plan for
+// the first `i` uf-sets with `j` people in p1.
+unsigned long long reachable[MAX_N][WORDS];
+// Bit `j` is set if there are more than one such plans,
+// for the current uf-set and the last one.
+unsigned long long multiple[2][WORDS];
+
+// dst |= src << shift, over bitsets of WORDS words.
+void shift_or(unsigned long long* dst, const unsigned long long* src, int shift) {
+  int words = shift / 64, bits = shift % 64;
+  for (int w = WORDS-1; w >= words; w--) {
+    unsigned long long x = src[w-words] << bits;
+    if (bits && w-words > 0) x |= src[w-words-1] >> (64-bits);
+    dst[w] |= x;
+  }
+}
+
+// Whether bit `j` of a bitset is set.
+int test_bit(const unsigned long long* bits, int j) {
+  return bits[j/64] >> (j%64) & 1;
+}
+
+int main() {
+
+  int n, p1, p2;
+
+  // Start to handle tasks
+  while (1) {
+    read_int(&n), read_int(&p1), read_int(&p2);
+    if (!n && !p1 && !p2)
+      return 0;
+
+    // Initialize all global data structures
+    // People are numbered from 1 to p1+p2, and
+    // rows of uf_sets are cleared once assigned.
+    uf_set.init(p1+p2);
+    memset(uf_set_in, 0, sizeof(int)*(p1+p2+1));
+    uf_set_num = 0;
+
+    // Read all statements and build uf-sets
+    for (int i = 1; i <= n; i++) {
+      int xi, yi, root_xi, root_yi, same_group;
+      char ai[4];
+      read_int(&xi), read_int(&yi), read_str(ai);
+
+      // Find the uf-sets containing xi and yi
+      root_xi = uf_set.find(xi);
+      root_yi = uf_set.find(yi);
+
+      // If a said b is divine, a and b belong to the same group.
+      // Elsewise, a and b belong to different groups.
+      same_group = (ai[0] == 'y');
+
+      // Merge two uf-sets and update part of the relations
+      // This part is described in `1182.cc`.
+      if (root_xi != root_yi) {
+        uf_set.merge(root_xi, root_yi, uf_set.relation(xi) ^ uf_set.relation(yi) ^ !same_group);
+      }
+    }
+
+    // Record the relations into `uf_sets`,
+    // make it more convenient to apply DP.
+    for (int i = 1; i <= p1+p2; i++) {
+
+      // If this uf_set has not been recorded,
+      // assign a serial to it.
+      int root_i = uf_set.find(i);
+      if (uf_set_in[root_i] == 0) {
+        uf_set_in[root_i] = ++uf_set_num;
+        uf_sets[uf_set_num][SAME] = uf_sets[uf_set_num][DIFF] = 0;
+      }
+
+      // Increase the number of this kind of people
+      // in the uf-set it locates.
+      uf_sets[uf_set_in[root_i]][uf_set.relation(i)]++;
+    }
+
+    // Use DP to find the number of possible solutions
+    memset(reachable[0], 0, sizeof(reachable[0]));
+    memset(multiple[0], 0, sizeof(multiple[0]));
+    reachable[0][0] = 1;
+    for (int i = 1; i <= uf_set_num; i++) {
+      int a = uf_sets[i][SAME], b = uf_sets[i][DIFF];
+      unsigned long long* cur = reachable[i];
+      unsigned long long* more = multiple[i%2];
+      const unsigned long long* last = reachable[i-1];
+      const unsigned long long* last_more = multiple[(i-1)%2];
+
+      // Both groups in an uf-set could be chosen
+      unsigned long long by_a[WORDS] = {0}, by_b[WORDS] = {0};
+      shift_or(by_a, last, a);
+      shift_or(by_b, last, b);
+      memset(more, 0, sizeof(multiple[0]));
+      shift_or(more, last_more, a);
+      shift_or(more, last_more, b);
+      for (int w = 0; w < WORDS; w++) {
+        cur[w] = by_a[w] | by_b[w];
+        more[w] |= by_a[w] & by_b[w];
+      }
+    }
+
+    // If the solution is unique, print people in p1.
+    // Elsewise, print "no".
+    if (test_bit(reachable[uf_set_num], p1) && !test_bit(multiple[uf_set_num%2], p1)) {
+
+      // Trace back the process of DP, mark each
+      // chosen group.
+      int j = p1;
+      int chosen_group[MAX_N];
+
+      for (int i = uf_set_num; i >= 1; i--) {
+        if (j >= uf_sets[i][SAME] && test_bit(reachable[i-1], j-uf_sets[i][SAME])) {
+          chosen_group[i] = SAME;
+          j -= uf_sets[i][SAME];
+        } else {
+          chosen_group[i] = DIFF;
+          j -= uf_sets[i][DIFF];
+        }
+      }
+
+      // Print all chosen serials
+      for (int i = 1; i <= p1+p2; i++) {
+        int root_i = uf_set.find(i);
+        if (uf_set.relation(i) == chosen_group[uf_set_in[root_i]])
+          printf("%d\n", i);
+      }
+      printf("end\n");
+
+    } else {
+      printf("no\n");
+    }
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -8,9 +8,9 @@
  * is kind of disgusting as several random blanks may
  * be added between words.
  * 
- * Fortunately, scanf() is powerful, and it would be
- * much easier to deal with the awful input if we make
- * use of it.
+ * Fortunately, the readers in lib/fastio.h skip blanks
+ * before each token, so we only need to skip the `:(`
+ * and `)` literals around numbers with skip_char().
  * 
  */
 
@@ -18,6 +18,8 @@
 #include <cstdio>
 #include <vector>
 #include <cstring>
+
+#include "lib/fastio.h"
 using std::vector;
 
 #define MAX_N 1000
@@ -52,10 +54,18 @@ bool is_child[MAX_N];
 // We do not need find_update() here
 // because no extra operation is needed.
 //
-// Note that we applied a path compression
-// with parent[x] = find(parent[x]).
+// Note that we applied a path compression: all nodes
+// on the path are pointed to the root. It's done in two
+// passes instead of recursion, to keep the stack bounded.
 int find(int x) {
-  return (x == parent[x]) ? x : (parent[x] = find(parent[x]));
+  int root = x;
+  while (root != parent[root]) root = parent[root];
+  while (x != root) {
+    int next = parent[x];
+    parent[x] = root;
+    x = next;
+  }
+  return root;
 }
 
 // merge two uf-sets `a` and `b`.
@@ -69,26 +79,49 @@ void merge(int a, int b) {
  * Tarjian algo
  */
 
-void tarjian(int x) {
+// The explicit stack of DFS.
+//
+// dfs_stack[i] is a node on the path from root, and
+// dfs_next[i] is the next child of it to visit.
+int dfs_stack[MAX_N];
+size_t dfs_next[MAX_N];
+
+// Tarjian algo with an explicit stack instead of recursion,
+// the order of visits is the same as the recursive one.
+void tarjian(int root) {
+  int top = 0;
 
   // Assign a new uf-set to this node
-  parent[x] = x;
+  parent[root] = root;
+  dfs_stack[top] = root;
+  dfs_next[top++] = 0;
+
+  while (top) {
+    int x = dfs_stack[top-1];
+
+    // Visit the next child of x, it will be merged
+    // into the uf-set of x once it's done.
+    if (dfs_next[top-1] < children[x].size()) {
+      int child = children[x][dfs_next[top-1]++];
+      parent[child] = child;
+      dfs_stack[top] = child;
+      dfs_next[top++] = 0;
+      continue;
+    }
 
-  // For each child of x, tarjian it and merge it into
-  // the uf-set of x.
-  for (int i = 0; i < children[x].size(); i++) {
-    tarjian(children[x][i]);
-    merge(x, children[x][i]);
-  }
+    // As tarjian algo uses DFS, we visit x after
+    // all children are done.
+    visited[x] = true;
 
-  // As tarjian algo uses DFS, we visit x after
-  // the recursive call.
-  visited[x] = true;
+    // Respond to queries
+    for (size_t i = 0; i < queries[x].size(); i++) {
+      if (!visited[queries[x][i]]) continue;
+      cnt[find(queries[x][i])]++;
+    }
 
-  // Respond to queries
-  for (int i = 0; i < queries[x].size(); i++) {
-    if (!visited[queries[x][i]]) continue;
-    cnt[find(queries[x][i])]++;
+    // Return to the parent, and merge x into it.
+    top--;
+    if (top) merge(dfs_stack[top-1], x);
   }
 }
 
@@ -99,14 +132,17 @@ int main() {
   // Number of queries
   int num_queries;
 
-  while (scanf("%d", &n) == 1) {
-
-    // Clear the memory of global variables
-    memset(parent, 0, sizeof(parent));
-    memset(is_child, 0, sizeof(is_child));
-    memset(visited, 0, sizeof(visited));
-    memset(cnt, 0, sizeof(cnt));
-    for (int i = 0; i < MAX_N; i++) {
+  while (read_int(&n)) {
+
+    // Clear the memory of global variables.
+    // Vertices are numbered from 1 to n, so only
+    // that part is cleared, and vectors keep their
+    // buffers for the next case.
+    for (int i = 0; i <= n; i++) {
+      parent[i] = 0;
+      is_child[i] = false;
+      visited[i] = false;
+      cnt[i] = 0;
       children[i].clear();
       queries[i].clear();
     }
@@ -114,26 +150,27 @@ int main() {
     // Read the structure of tree from input
     for (int i = 0; i < n; i++) {
       int node, num_child, child;
-      scanf("%d:(%d)", &node, &num_child);
+      read_int(&node), skip_char(':'), skip_char('(');
+      read_int(&num_child), skip_char(')');
 
       // Record each child, and mark them as child.
       // After the loop, the not marked node is root.
       for (int j = 1; j <= num_child; j++) {
-        scanf("%d", &child);
+        read_int(&child);
         children[node].push_back(child);
         is_child[child] = true;
       }
     }
 
     // Read all queries
-    scanf("%d", &num_queries);
+    read_int(&num_queries);
     for (int i = 0; i < num_queries; i++) {
 
       // As the question prompted, the input may be
-      // divided by several spaces, so we add a space
-      // in the front of formatting string.
+      // divided by several spaces, which are skipped
+      // before each literal and number.
       int u, v;
-      scanf(" (%d %d)", &u, &v);
+      skip_char('('), read_int(&u), read_int(&v), skip_char(')');
       queries[u].push_back(v);
       queries[v].push_back(u);
     }
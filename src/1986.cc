@@ -15,16 +15,36 @@
  * size of your arrays are large enough, redesign your algorithm
  * or data structure to reduce the time complexity.
  * 
+ * Tarjan's algorithm is offline: no query is answered before all
+ * of them are read. So there is an online mode as well, which
+ * records an Euler tour of the tree and builds a sparse table of
+ * the shallowest node in each range of the tour. LCA(u, v) is the
+ * shallowest node between the first visits of u and v, so each
+ * query is answered in O(1) as soon as it's read.
+ * 
+ * Pick the mode by the first command-line argument:
+ * 
+ * - euler: the online mode (default)
+ * - tarjan: the offline mode
+ * 
  */
 
 #include <cstdio>
 #include <vector>
 #include <cstring>
+
+#include "lib/fastio.h"
 using std::vector;
 
 #define MAX_NUM 40001
-#define MAX_LEN 1001
-#define MAX_QUERIES 10001
+// 2^MAX_LOG > length of the Euler tour
+#define MAX_LOG 17
+
+// Modes
+enum mode {
+  ONLINE,
+  OFFLINE,
+};
 
 // Use a structure to record the
 // weight of edges
@@ -58,7 +78,9 @@ bool visited[MAX_NUM];
 // The distance between root and this node.
 int distance[MAX_NUM];
 
-int answers[MAX_NUM];
+// Answers of queries in the offline mode, sized by the
+// number of queries, which is not limited in the online mode.
+vector<int> answers;
 
 /*
  * uf-set APIs
@@ -67,10 +89,18 @@ int answers[MAX_NUM];
 // We do not need find_update() here
 // because no extra operation is needed.
 //
-// Note that we applied a path compression
-// with parent[x] = find(parent[x]).
+// Note that we applied a path compression: all nodes
+// on the path are pointed to the root. It's done in two
+// passes instead of recursion, to keep the stack bounded.
 int find(int x) {
-  return (x == parent[x]) ? x : (parent[x] = find(parent[x]));
+  int root = x;
+  while (root != parent[root]) root = parent[root];
+  while (x != root) {
+    int next = parent[x];
+    parent[x] = root;
+    x = next;
+  }
+  return root;
 }
 
 // merge two uf-sets `a` and `b`.
@@ -84,62 +114,182 @@ void merge(int a, int b) {
  * Tarjian algo
  */
 
-void tarjian(int x) {
+// The explicit stack of DFS.
+//
+// dfs_stack[i] is a node on the path from root, and
+// dfs_next[i] is the next edge of it to visit.
+int dfs_stack[MAX_NUM];
+size_t dfs_next[MAX_NUM];
+
+// Tarjian algo with an explicit stack instead of recursion,
+// which overflows the stack on path-shaped farms. The order
+// of visits is the same as the recursive one.
+void tarjian(int root) {
+  int top = 0;
 
   // Assign a new uf-set to this node
-  parent[x] = x;
-
+  //
   // This time we're facing a graph with cycle instead
-  // of tree, so put this ahead of the recursive call.
-  visited[x] = true;
-
-  // For each child of x, tarjian it and merge it into
-  // the uf-set of x.
-  // We also calculate the distance to this child here.
-  for (int i = 0; i < children[x].size(); i++) {
-
-    // Only visit unvisited nodes to avoid infinite call.
-    if (!visited[children[x][i].id]) {
-      distance[children[x][i].id] = distance[x] + children[x][i].weight;
-      tarjian(children[x][i].id);
-      merge(x, children[x][i].id);
+  // of tree, so mark it as visited as soon as we enter it.
+  parent[root] = root;
+  visited[root] = true;
+  dfs_stack[top] = root;
+  dfs_next[top++] = 0;
+
+  while (top) {
+    int x = dfs_stack[top-1];
+
+    // Visit the next unvisited child of x, it will be
+    // merged into the uf-set of x once it's done.
+    // We also calculate the distance to this child here.
+    if (dfs_next[top-1] < children[x].size()) {
+      node child = children[x][dfs_next[top-1]++];
+
+      // Only visit unvisited nodes to avoid infinite loop.
+      if (!visited[child.id]) {
+        distance[child.id] = distance[x] + child.weight;
+        parent[child.id] = child.id;
+        visited[child.id] = true;
+        dfs_stack[top] = child.id;
+        dfs_next[top++] = 0;
+      }
+      continue;
+    }
+
+    // Respond to queries
+    for (size_t i = 0; i < queries[x].size(); i++) {
+      if (!visited[queries[x][i].to]) continue;
+
+      // Dist(u，v) = Dist(1，u) + Dist(1，v) - 2*Dist(1，LCA(u，v))
+      //
+      // Synchronize the answer between i->j and j->i as
+      // queries[x][i] == queries[x][i^1].
+      answers[queries[x][i].id] = 
+        distance[x] + distance[queries[x][i].to] - 2*distance[find(queries[x][i].to)];
+    }
+
+    // Return to the parent, and merge x into it.
+    top--;
+    if (top) merge(dfs_stack[top-1], x);
+  }
+}
+
+/*
+ * Euler tour APIs
+ */
+
+// euler[i]: the `i`th node visited in the Euler tour, each node
+// appears when it's entered and after each of its children.
+int euler[2*MAX_NUM];
+int euler_len;
+// first[x]: the first position of `x` in euler[].
+int first[MAX_NUM];
+// depth[x]: the number of edges between root and `x`.
+int depth[MAX_NUM];
+
+// sparse[k][i]: the shallowest node in euler[i..i+2^k).
+int sparse[MAX_LOG][2*MAX_NUM];
+
+// The shallower one of two nodes.
+inline int shallower(int a, int b) {
+  return depth[a] < depth[b] ? a : b;
+}
+
+// Record the Euler tour from `root`, and the distance and depth
+// of each node on the way. The DFS is the same as tarjian().
+void euler_tour(int root) {
+  int top = 0;
+
+  euler_len = 0;
+  visited[root] = true;
+  depth[root] = 0;
+  first[root] = euler_len;
+  euler[euler_len++] = root;
+  dfs_stack[top] = root;
+  dfs_next[top++] = 0;
+
+  while (top) {
+    int x = dfs_stack[top-1];
+
+    if (dfs_next[top-1] < children[x].size()) {
+      node child = children[x][dfs_next[top-1]++];
+      if (!visited[child.id]) {
+        distance[child.id] = distance[x] + child.weight;
+        depth[child.id] = depth[x] + 1;
+        visited[child.id] = true;
+        first[child.id] = euler_len;
+        euler[euler_len++] = child.id;
+        dfs_stack[top] = child.id;
+        dfs_next[top++] = 0;
+      }
+      continue;
     }
+
+    // Return to the parent, which appears again in the tour.
+    top--;
+    if (top) euler[euler_len++] = dfs_stack[top-1];
   }
+}
 
-  // Respond to queries
-  for (int i = 0; i < queries[x].size(); i++) {
-    if (!visited[queries[x][i].to]) continue;
+// Build sparse[][] over the Euler tour.
+void build_sparse() {
+  memcpy(sparse[0], euler, sizeof(int)*euler_len);
+  for (int k = 1; (1 << k) <= euler_len; k++) {
+    int half = 1 << (k-1);
+    for (int i = 0; i + 2*half <= euler_len; i++)
+      sparse[k][i] = shallower(sparse[k-1][i], sparse[k-1][i+half]);
+  }
+}
 
-    // Dist(u，v) = Dist(1，u) + Dist(1，v) - 2*Dist(1，LCA(u，v))
-    //
-    // Synchronize the answer between i->j and j->i as
-    // queries[x][i] == queries[x][i^1].
-    answers[queries[x][i].id] = 
-      distance[x] + distance[queries[x][i].to] - 2*distance[find(queries[x][i].to)];
+// The lowest common ancestor of `u` and `v`.
+int lca(int u, int v) {
+  int l = first[u], r = first[v];
+  if (l > r) {
+    int tmp = l;
+    l = r, r = tmp;
   }
+
+  // Two overlapping ranges of length 2^k cover [l, r].
+  int k = 31 - __builtin_clz(r - l + 1);
+  return shallower(sparse[k][l], sparse[k][r - (1 << k) + 1]);
 }
 
-int main() {
+int main(int argc, char** argv) {
+
+  // Pick the mode
+  int mode = ONLINE;
+  if (argc > 1) {
+    if (!strcmp(argv[1], "euler")) mode = ONLINE;
+    else if (!strcmp(argv[1], "tarjan")) mode = OFFLINE;
+    else {
+      fprintf(stderr, "usage: %s [euler|tarjan]\n", argv[0]);
+      return 1;
+    }
+  }
 
   int num_farms;
   int num_roads;
   int num_queries;
 
-  while (scanf("%d%d", &num_farms, &num_roads) == 2) {
+  while (read_int(&num_farms) && read_int(&num_roads)) {
 
-    // Clear the memory of global variables
-    memset(parent, 0, sizeof(parent));
-    memset(visited, 0, sizeof(visited));
-    memset(distance, 0, sizeof(distance));
-    memset(queries, 0, sizeof(queries));
-    for (int i = 0; i < MAX_NUM; i++) {
+    // Clear the memory of global variables.
+    // Farms are numbered from 1 to num_farms, so only
+    // that part is cleared, and vectors keep their
+    // buffers for the next case.
+    for (int i = 0; i <= num_farms; i++) {
+      parent[i] = 0;
+      visited[i] = false;
+      distance[i] = 0;
       children[i].clear();
+      queries[i].clear();
     }
 
     // Read the structure of graph from input
     for (int i = 0; i < num_roads; i++) {
-      int start, end, length, direction;
-      scanf("%d%d%d %c", &start, &end, &length, &direction);
+      int start, end, length;
+      char direction;
+      read_int(&start), read_int(&end), read_int(&length), read_char(&direction);
 
       // Record each child.
       // The road is directless, so we record
@@ -155,14 +305,29 @@ int main() {
     }
 
     // Read all queries
-    scanf("%d", &num_queries);
-    for (int i = 0; i < num_queries; i++) {
+    read_int(&num_queries);
+
+    // In the online mode, preprocess the tree and
+    // answer each query right after it's read.
+    if (mode == ONLINE) {
+      euler_tour(1);
+      build_sparse();
+
+      for (int i = 0; i < num_queries; i++) {
+        int u, v;
+        read_int(&u), read_int(&v);
+
+        // Dist(u，v) = Dist(1，u) + Dist(1，v) - 2*Dist(1，LCA(u，v))
+        write_int(distance[u] + distance[v] - 2*distance[lca(u, v)]);
+        write_char('\n');
+      }
+      continue;
+    }
 
-      // As the question prompted, the input may be
-      // divided by several spaces, so we add a space
-      // in the front of formatting string.
+    answers.assign(num_queries, 0);
+    for (int i = 0; i < num_queries; i++) {
       int u, v;
-      scanf("%d%d", &u, &v);
+      read_int(&u), read_int(&v);
 
       // For each query, we need to add two symmetric
       // queries, because we don't know which node would
@@ -183,9 +348,11 @@ int main() {
     // Since adjacent queries are symmetric, we only need
     // to print the answer of one of them.
     for (int i = 0; i < num_queries; i++) {
-      printf("%d\n", answers[i]);
+      write_int(answers[i]);
+      write_char('\n');
     }
   }
 
+  flush_output();
   return 0;
 }
\ No newline at end of file
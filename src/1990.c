@@ -35,12 +35,44 @@
  * prefix_sum(t) could be easily queried from BIT. We keep two BITs:
  * one for num_j{x_i>x_j}, one for prefix_sum.
  * 
+ * Indexing the BITs by x axis caps x axes at the size of the BITs, so
+ * x axes are compressed to their ranks among all cows first. The two
+ * BITs are fused into one array of {count, sum} pairs, so an update or
+ * a query walks a single cache line per level. All buffers are sized
+ * by N, so there's no cap on cows or x axes other than int.
+ * 
+ * The radix sort takes keys as unsigned, so signed keys are biased by
+ * flipping their sign bit first, which keeps negative ones in front.
+ * Distances don't change when all x axes are biased alike, so the cdq
+ * engine works on the biased ones directly.
+ * 
+ * With millions of cows the answer no longer fits in 64 bits, so it's
+ * summed up in 128 bits.
+ * 
+ * The BIT sweep is sequential by nature. The cdq engine computes the
+ * same sum by divide & conquer over the cows sorted by threshold
+ * (CDQ): every cow in the right half is louder than every cow in the
+ * left half, so once both halves are sorted by x axis, merging them
+ * (as in merge sort) counts the distances between the halves with
+ * running sums of the left half. The halves are independent, so they
+ * are solved in parallel by fork-join threads.
+ * 
+ * Pick the engine by the first command-line argument:
+ * 
+ * - bit: the BIT sweep (default)
+ * - cdq [threads]: the divide & conquer, on `threads` threads, all
+ *   online cores by default
+ * 
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
 
-#define MAX_N 20000
+#include "lib/fastio.h"
+#include "lib/radix_sort.h"
 
 /*
  * Standard BIT API
@@ -49,88 +81,247 @@
 // LST(x) is the lowest 1 in x's binary representation.
 #define LST(x) ((x) & (-(x)))
 
-// Update the BIT by adding `x` to `BIT[pos]`
+// A node of the fused BIT, over cows with
+// x axis rank in a certain range.
+typedef struct {
+  long long count; // the number of cows
+  long long sum; // the sum of their x axes
+} bit_node;
+
+// Add a cow at x axis `x` with rank `pos` to the BIT.
 // `range` indicates the size of BIT.
-void bit_update(int* bit, int pos, int range, int x) {
+void bit_update(bit_node* bit, int pos, int range, int x) {
 
   while (pos <= range) {
-    bit[pos] += x;
+    bit[pos].count++;
+    bit[pos].sum += x;
     pos += LST(pos);
   }
 }
 
-// Return the total number of apples on forks
-// not greater than `pos`.
-long long bit_query(int* bit, int pos) {
+// Return the number of cows and the sum of their
+// x axes, over cows with rank not greater than `pos`.
+bit_node bit_query(bit_node* bit, int pos) {
 
-  long long sum = 0;
+  bit_node ret = {0, 0};
   while (pos > 0) {
-    sum += bit[pos];
+    ret.count += bit[pos].count;
+    ret.sum += bit[pos].sum;
     pos -= LST(pos);
   }
 
-  return sum;
+  return ret;
 }
 
 /*
  * Cow object
  */
 
-typedef struct {
-  int threshold;
-  int x_axis;
-} cow;
+// Engines
+enum engine {
+  BIT,
+  CDQ,
+};
 
-// The comparation function that helps sorting.
-int cow_cmp(const void* a, const void* b) {
-  return ((cow*)a)->threshold - ((cow*)b)->threshold;
+// A cow is a record for radix sort, keyed by its
+// volume threshold, carrying its x axis as payload.
+typedef struct radix_pair32 cow;
+
+// Bias a signed key for the radix sort, and back.
+static inline unsigned bias(int x) { return (unsigned)x ^ 0x80000000u; }
+static inline int unbias(unsigned key) { return (int)(key ^ 0x80000000u); }
+
+// Print a non-negative 128-bit integer.
+void print_int128(__int128 x) {
+  const long long e18 = 1000000000000000000LL;
+  if (x >= e18) printf("%lld%018lld\n", (long long)(x / e18), (long long)(x % e18));
+  else printf("%lld\n", (long long)x);
 }
 
 /*
- * Global variables
+ * CDQ APIs
  */
 
-// All cows inputted
-cow cows[MAX_N];
+// Segments no longer than this are solved by brute force.
+#define CDQ_LEAF 16
+
+// Segments no longer than this are not worth a new thread.
+#define CDQ_MIN_FORK 4096
 
-// Use two BITs to record:
-//
-// num_smaller_x[i] records the number of cows
-// which has smaller x axis than `i`.
-int num_smaller_x[MAX_N];
-// sum_smaller_x[i] records the sum of x axes
-// which are smaller than `i`'s x axis.
-int sum_smaller_x[MAX_N];
+// Cows as {biased x axis, threshold} in threshold order, which
+// get sorted by x axis segment by segment, and a buffer
+// to merge them.
+struct radix_pair32 *cdq_axes, *cdq_tmp;
 
-int main() {
+// Sum up max{v_i, v_j} * |x_i - x_j| over all pairs in
+// cdq_axes[lo, hi), and sort the segment by x axis.
+__int128 cdq(int lo, int hi, int threads);
+
+// A half of a segment, solved by another thread.
+typedef struct {
+  int lo, hi, threads;
+  __int128 result;
+} cdq_task;
+
+void* cdq_thread(void* arg) {
+  cdq_task* task = arg;
+  task->result = cdq(task->lo, task->hi, task->threads);
+  return NULL;
+}
+
+__int128 cdq(int lo, int hi, int threads) {
+  struct radix_pair32* axes = cdq_axes;
+  __int128 result = 0;
+
+  // Brute force, and insertion sort.
+  if (hi - lo <= CDQ_LEAF) {
+    for (int j = lo+1; j < hi; j++) {
+      long long x = axes[j].key;
+      for (int i = lo; i < j; i++)
+        result += (long long)axes[j].value * (x > axes[i].key ? x - axes[i].key : axes[i].key - x);
+    }
+    for (int j = lo+1; j < hi; j++) {
+      struct radix_pair32 cur = axes[j];
+      int i = j;
+      for (; i > lo && axes[i-1].key > cur.key; i--) axes[i] = axes[i-1];
+      axes[i] = cur;
+    }
+    return result;
+  }
+
+  // Fork: solve the left half on another thread with
+  // half of the threads, or here if it's not worth it.
+  int mid = (lo+hi)/2;
+  pthread_t thread;
+  cdq_task left = {lo, mid, threads/2, 0};
+  int forked = threads > 1 && hi - lo > CDQ_MIN_FORK &&
+    pthread_create(&thread, NULL, cdq_thread, &left) == 0;
+  if (forked) {
+    result += cdq(mid, hi, threads - threads/2);
+    pthread_join(thread, NULL);
+    result += left.result;
+  } else {
+    result += cdq(lo, mid, 1);
+    result += cdq(mid, hi, 1);
+  }
+
+  // Join: merge two halves by x axis. For each cow in the
+  // right half, the cows in the left half with no larger
+  // x axis have been merged before it.
+  long long left_sum = 0;
+  for (int i = lo; i < mid; i++) left_sum += axes[i].key;
+
+  long long num = 0, sum_smaller = 0;
+  int i = lo, j = mid, k = lo;
+  while (k < hi) {
+    if (j == hi || (i < mid && axes[i].key <= axes[j].key)) {
+      num++, sum_smaller += axes[i].key;
+      cdq_tmp[k++] = axes[i++];
+    } else {
+      long long x = axes[j].key;
+      long long sum_higher = left_sum - sum_smaller;
+      result += (__int128)axes[j].value *
+        ((num*x - sum_smaller) + (sum_higher - (mid-lo-num)*x));
+      cdq_tmp[k++] = axes[j++];
+    }
+  }
+  memcpy(axes+lo, cdq_tmp+lo, sizeof(struct radix_pair32) * (hi-lo));
+
+  return result;
+}
+
+int main(int argc, char** argv) {
+
+  // Pick the engine
+  int mode = BIT;
+  int threads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (argc > 1) {
+    if (!strcmp(argv[1], "bit")) mode = BIT;
+    else if (!strcmp(argv[1], "cdq")) mode = CDQ;
+    else {
+      fprintf(stderr, "usage: %s [bit|cdq [threads]]\n", argv[0]);
+      return 1;
+    }
+    if (argc > 2) threads = atoi(argv[2]);
+    if (threads < 1) threads = 1;
+  }
 
   int N;
-  long long result = 0;
-  scanf("%d", &N);
-  
+  read_int(&N);
+
+  // All cows inputted, and a buffer to sort them.
+  cow* cows = malloc(sizeof(cow) * (N+1));
+  cow* cows_tmp = malloc(sizeof(cow) * (N+1));
+
   // Get the voice threshold and x axes of all cows.
   for (int i = 0; i < N; i++) {
-    scanf("%d%d", &cows[i].threshold, &cows[i].x_axis);
+    int threshold;
+    read_int(&threshold), read_int(&cows[i].value);
+    cows[i].key = bias(threshold);
+  }
+
+  // Sort the cows by threshold.
+  radix_sort_pairs32(cows, cows_tmp, N);
+
+  if (mode == CDQ) {
+    cdq_axes = cows_tmp;
+    cdq_tmp = malloc(sizeof(struct radix_pair32) * (N+1));
+    for (int i = 0; i < N; i++) {
+      cdq_axes[i].key = bias(cows[i].value);
+      cdq_axes[i].value = unbias(cows[i].key);
+    }
+    print_int128(cdq(0, N, threads));
+
+    free(cows), free(cdq_axes), free(cdq_tmp);
+    return 0;
+  }
+
+  // Compress x axes: sort {x axis, position} pairs
+  // by x axis, and rank[i] is the rank of cows[i]'s
+  // x axis among all distinct ones, from 1.
+  struct radix_pair32* axes = cows_tmp;
+  struct radix_pair32* axes_tmp = malloc(sizeof(struct radix_pair32) * (N+1));
+  int* rank = malloc(sizeof(int) * (N+1));
+  for (int i = 0; i < N; i++) {
+    axes[i].key = bias(cows[i].value);
+    axes[i].value = i;
   }
+  radix_sort_pairs32(axes, axes_tmp, N);
 
-  // Sort the cows.
-  qsort((void *)cows, N, sizeof(cow), cow_cmp);
+  int num_ranks = 0;
+  for (int i = 0; i < N; i++) {
+    if (i == 0 || axes[i].key != axes[i-1].key) num_ranks++;
+    rank[axes[i].value] = num_ranks;
+  }
+  free(axes), free(axes_tmp);
 
-  // Do the calculation as the algorithm describes.
-  for (int i = 1; i < N; i++) {
-    bit_update(num_smaller_x, cows[i-1].x_axis, MAX_N, 1);
-    bit_update(sum_smaller_x, cows[i-1].x_axis, MAX_N, cows[i-1].x_axis);
+  // The fused BIT over ranks, and the sum of
+  // x axes of all cows added to it.
+  bit_node* bit = calloc(num_ranks+1, sizeof(bit_node));
+  long long sum_all = 0;
 
-    long long num = bit_query(num_smaller_x, cows[i].x_axis);
-    long long sum_smaller = bit_query(sum_smaller_x, cows[i].x_axis);
-    long long sum_higher = bit_query(sum_smaller_x, MAX_N) - sum_smaller;
+  // Do the calculation as the algorithm describes,
+  // against the cows before `i`.
+  __int128 result = 0;
+  for (int i = 0; i < N; i++) {
+    int threshold = unbias(cows[i].key), x_axis = cows[i].value;
+
+    bit_node smaller = bit_query(bit, rank[i]);
+    long long num = smaller.count;
+    long long sum_smaller = smaller.sum;
+    long long sum_higher = sum_all - sum_smaller;
+
+    result += (__int128)threshold * 
+      ((num*x_axis - sum_smaller) + 
+      (sum_higher - (i-num)*x_axis));
 
-    result += cows[i].threshold * 
-      ((num*cows[i].x_axis - sum_smaller) + 
-      (sum_higher - (i-num)*cows[i].x_axis));
+    bit_update(bit, rank[i], num_ranks, x_axis);
+    sum_all += x_axis;
   }
 
-  printf("%lld\n", result);
+  print_int128(result);
+
+  free(cows), free(rank), free(bit);
   return 0;
 
-}
\ No newline at end of file
+}
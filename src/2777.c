@@ -14,17 +14,78 @@
  * problem's testcases, so a solution without lazy propagation
  * would not be fast enough.
  * 
+ * A single int caps the palette at about 30 colors, so the set of
+ * colors is a mask of MAX_COLORS bits in 64-bit words instead (color
+ * `c` is bit c-1). merge() ORs the words in a fixed-length loop that
+ * the compiler vectorizes, and the colors are counted by hardware
+ * popcount. Build with -DMAX_COLORS=256 for larger palettes.
+ * 
+ * The textbook tree above recurses from the root with four range
+ * parameters per call, and keeps the colors and the lazy marks in
+ * two separate arrays. The default engine is an iterative tree of a
+ * power-of-two size instead: a range covers the nodes between two
+ * leaves, which are walked bottom-up, and the marks on their
+ * ancestors are pushed down top-down beforehand. Each node holds its
+ * colors and its mark together, so a visit touches one cache line.
+ * 
+ * Pick the engine by the first command-line argument:
+ * 
+ * - iterative: the bottom-up tree (default)
+ * - recursive: the textbook tree
+ * 
  */
 
 #include <stdio.h>
+#include <string.h>
+
+#include "lib/fastio.h"
 
 // MAX_L = MAX_O = MAX_N
 #define MAX_N 100002
+// The number of leaves in the iterative tree,
+// a power of 2 no less than MAX_N.
+#define MAX_SIZE (1 << 17)
+
+// The max number of colors.
+#ifndef MAX_COLORS
+#define MAX_COLORS 64
+#endif
+#define MASK_WORDS ((MAX_COLORS + 63) / 64)
 
 #define swap(x, y) do {x^=y; y^=x; x^=y;} while(0)
 
+// Segment tree engines
+enum engine {
+  ITERATIVE,
+  RECURSIVE,
+};
+
 /*
- * Segment tree APIs
+ * Color mask APIs
+ */
+
+// A set of colors, each bit represents an unique color.
+typedef struct {
+  unsigned long long word[MASK_WORDS];
+} color_mask;
+
+// The mask with color `c` only.
+color_mask single_color(int c) {
+  color_mask mask = {{0}};
+  mask.word[(c-1) / 64] = 1ULL << ((c-1) % 64);
+  return mask;
+}
+
+// Return the number of colors in `mask`.
+int count_colors(color_mask mask) {
+  int cnt = 0;
+  for (int i = 0; i < MASK_WORDS; i++)
+    cnt += __builtin_popcountll(mask.word[i]);
+  return cnt;
+}
+
+/*
+ * Recursive segment tree APIs
  */
 
 // Colors in this node's segment, 
@@ -34,7 +95,7 @@
 // segment tree, all operations affect
 // this array. It could have different
 // meanings, in this case it's colors.
-int seg_tree[MAX_N*4];
+color_mask seg_tree[MAX_N*4];
 
 // The mark for lazy propagation.
 //
@@ -44,8 +105,9 @@ int seg_tree[MAX_N*4];
 // when we pass through this node to visit
 // its children.
 //
-// The value of dirty[i] should satisfy:
-// value[child] = merge(value[child], dirty[parent])
+// Here the change is always painting the whole
+// segment with color x, so an int is enough to
+// record it, and 0 means the node is clean.
 int dirty[MAX_N*4];
 
 // User interface of segment tree.
@@ -53,8 +115,11 @@ int dirty[MAX_N*4];
 // tree may have different meaniings, this function
 // is used to merge the value of two children to
 // their parent.
-int merge(int a, int b) {
-  return a|b;
+color_mask merge(color_mask a, color_mask b) {
+  color_mask ret;
+  for (int i = 0; i < MASK_WORDS; i++)
+    ret.word[i] = a.word[i] | b.word[i];
+  return ret;
 }
 
 // Init the segment tree.
@@ -68,7 +133,7 @@ void init_tree(int root, int l, int r) {
   // at first, we record this information in
   // leaves of the tree.
   if (l == r) {
-    seg_tree[root] = 1<<1;
+    seg_tree[root] = single_color(1);
     return;
   }
 
@@ -90,7 +155,7 @@ void push_down(int root) {
     // Note that once a segment is painted by another
     // color, the former color disappears. So we should
     // not merge here, but replace instead.
-    seg_tree[root*2] = seg_tree[root*2+1] = dirty[root];
+    seg_tree[root*2] = seg_tree[root*2+1] = single_color(dirty[root]);
 
     // Propagate dirty mark to children.
     dirty[root*2] = dirty[root*2+1] = dirty[root];
@@ -106,14 +171,15 @@ void push_down(int root) {
 // @param l_up|r_up: the range to update
 // @param l_trav|r_trav: the range we're in now
 // @param root: the current tree node
-// @param val: the value to update
-void update_tree(int l_up, int r_up, int l_trav, int r_trav, int root, int val) {
+// @param color: the color to paint
+void update_tree(int l_up, int r_up, int l_trav, int r_trav, int root, int color) {
 
   // Update the segment and return right away if
   // we've found the proper segment, as we use
   // lazy propagation.
   if (l_up <= l_trav && r_up >= r_trav) {
-    seg_tree[root] = dirty[root] = val;
+    seg_tree[root] = single_color(color);
+    dirty[root] = color;
     return;
   }
 
@@ -124,9 +190,9 @@ void update_tree(int l_up, int r_up, int l_trav, int r_trav, int root, int val)
   // Typical divide & conquer.
   int mid = (l_trav+r_trav)/2;
   if (l_up <= mid)
-    update_tree(l_up, r_up, l_trav, mid, root*2, val);
+    update_tree(l_up, r_up, l_trav, mid, root*2, color);
   if (r_up > mid)
-    update_tree(l_up, r_up, mid+1, r_trav, root*2+1, val);
+    update_tree(l_up, r_up, mid+1, r_trav, root*2+1, color);
 
   seg_tree[root] = merge(seg_tree[root*2], seg_tree[root*2+1]);
 }
@@ -137,7 +203,7 @@ void update_tree(int l_up, int r_up, int l_trav, int r_trav, int root, int val)
 // @param l_query|r_query: the range to query
 // @param l_trav|r_trav: the range we're in now
 // @param root: the current tree node
-int query_tree(int l_query, int r_query, int l_trav, int r_trav, int root) {
+color_mask query_tree(int l_query, int r_query, int l_trav, int r_trav, int root) {
 
   // Exit from recursion.
   if (l_query <= l_trav && r_query >= r_trav) {
@@ -150,7 +216,7 @@ int query_tree(int l_query, int r_query, int l_trav, int r_trav, int root) {
 
   // Typical divide & conquer.
   int mid = (l_trav+r_trav)/2;
-  int ret = 0;
+  color_mask ret = {{0}};
   if (l_query <= mid)
     ret = merge(ret, query_tree(l_query, r_query, l_trav, mid, root*2));
   if (r_query > mid)
@@ -158,47 +224,151 @@ int query_tree(int l_query, int r_query, int l_trav, int r_trav, int root) {
   return ret;
 }
 
-// Return the number of 1 in `x`'s binary representation.
-//
-// We could use bit mask algorithm to implement a O(logN)
-// function here, but there's no need in this case.
-int bitcnt(int x) {
-  int cnt = 0;
-  while (x) {
-    if (x & 1) cnt++;
-    x >>= 1;
+/*
+ * Iterative segment tree APIs
+ */
+
+// A node of the iterative tree. The colors and
+// the lazy mark share the meaning of seg_tree[]
+// and dirty[] above.
+typedef struct {
+  color_mask colors;
+  int dirty;
+} seg_node;
+
+// node[1] is the root, and the children of
+// node[i] are node[i*2] and node[i*2+1].
+// Unit `i` of the board is the leaf node[size+i-1].
+seg_node node[MAX_SIZE*2];
+// The number of leaves, and log2 of it.
+int size, levels;
+
+// Paint the whole segment of node `k` with `color`.
+void paint_node(int k, int color) {
+  node[k].colors = single_color(color);
+  node[k].dirty = color;
+}
+
+// Push the dirty mark of node `k` down to its children.
+void push_node(int k) {
+  if (node[k].dirty) {
+    paint_node(k*2, node[k].dirty);
+    paint_node(k*2+1, node[k].dirty);
+    node[k].dirty = 0;
   }
+}
 
-  return cnt;
+// Recompute the colors of node `k` from its children.
+void pull_node(int k) {
+  node[k].colors = merge(node[k*2].colors, node[k*2+1].colors);
 }
 
-int main() {
+// Init the tree for a board of length `len`,
+// painted by color 1 at first.
+void build_nodes(int len) {
+  for (size = 1, levels = 0; size < len; size *= 2) levels++;
+
+  color_mask empty = {{0}};
+  for (int i = 0; i < size; i++) {
+    node[size+i].colors = i < len ? single_color(1) : empty;
+    node[size+i].dirty = 0;
+  }
+  for (int k = size-1; k > 0; k--) {
+    pull_node(k);
+    node[k].dirty = 0;
+  }
+}
+
+// Push down the marks on the ancestors of the bounds of
+// the leaf range [l, r), from the root to the leaves.
+// Nodes inside the range never need it.
+void push_bounds(int l, int r) {
+  for (int i = levels; i > 0; i--) {
+    if (((l >> i) << i) != l) push_node(l >> i);
+    if (((r >> i) << i) != r) push_node((r-1) >> i);
+  }
+}
+
+// Paint units [l, r] of the board with `color`.
+void update_range(int l, int r, int color) {
+  l += size-1, r += size;
+  push_bounds(l, r);
+
+  // Paint the nodes covering the range, from the
+  // leaves up, narrowing [a, b) on each level.
+  for (int a = l, b = r; a < b; a >>= 1, b >>= 1) {
+    if (a & 1) paint_node(a++, color);
+    if (b & 1) paint_node(--b, color);
+  }
+
+  // Only the ancestors of the bounds are partly painted.
+  for (int i = 1; i <= levels; i++) {
+    if (((l >> i) << i) != l) pull_node(l >> i);
+    if (((r >> i) << i) != r) pull_node((r-1) >> i);
+  }
+}
+
+// Colors in units [l, r] of the board.
+color_mask query_range(int l, int r) {
+  l += size-1, r += size;
+  push_bounds(l, r);
+
+  color_mask ret = {{0}};
+  for (; l < r; l >>= 1, r >>= 1) {
+    if (l & 1) ret = merge(ret, node[l++].colors);
+    if (r & 1) ret = merge(ret, node[--r].colors);
+  }
+  return ret;
+}
+
+int main(int argc, char** argv) {
+
+  // Pick the engine
+  int mode = ITERATIVE;
+  if (argc > 1) {
+    if (!strcmp(argv[1], "iterative")) mode = ITERATIVE;
+    else if (!strcmp(argv[1], "recursive")) mode = RECURSIVE;
+    else {
+      fprintf(stderr, "usage: %s [iterative|recursive]\n", argv[0]);
+      return 1;
+    }
+  }
 
   int L, T, O; // Variables defined by topic
-  char ope[2]; // Operation
+  char ope; // Operation
   int l, r, color; // Range and color
-  scanf("%d%d%d", &L, &T, &O);
+  read_int(&L), read_int(&T), read_int(&O);
+  if (T > MAX_COLORS) {
+    fprintf(stderr, "%d colors are more than MAX_COLORS (%d)\n", T, MAX_COLORS);
+    return 1;
+  }
 
   // Build up the segment tree.
-  init_tree(1, 1, L);
+  if (mode == ITERATIVE) build_nodes(L);
+  else init_tree(1, 1, L);
 
   // Get operations
   for (int i = 0; i < O; i++) {
-    scanf("%s", ope);
+    read_char(&ope);
 
     // Query
-    if (ope[0] == 'P') {
-      scanf("%d%d", &l, &r);
+    if (ope == 'P') {
+      read_int(&l), read_int(&r);
       if (l > r) swap(l, r); // The input is poisonous, this step is essential.
-      printf("%d\n", bitcnt(query_tree(l, r, 1, L, 1)));
+      color_mask colors = mode == ITERATIVE ? query_range(l, r)
+                                            : query_tree(l, r, 1, L, 1);
+      write_int(count_colors(colors));
+      write_char('\n');
 
     // Paint
     } else {
-      scanf("%d%d%d", &l, &r, &color);
+      read_int(&l), read_int(&r), read_int(&color);
       if (l > r) swap(l, r); // The input is poisonous, this step is essential.
-      update_tree(l, r, 1, L, 1, 1<<color);
+      if (mode == ITERATIVE) update_range(l, r, color);
+      else update_tree(l, r, 1, L, 1, color);
     }
   }
 
+  flush_output();
   return 0;
 }
\ No newline at end of file
@@ -9,11 +9,44 @@
  * like cxx and do not want to use std::priority_queue, so I decided
  * to pick SPFA with stack here.
  * 
+ * Well, SPFA with stack does not have a worst-case bound either, and
+ * it blows up on adversarial graphs. Since all `c` are non-negative,
+ * Dijkstra works here, so I implemented two heaps by hand at last:
+ * an indexed binary heap with decrease-key, and a radix heap which
+ * makes use of the fact that weights are integers. All engines are
+ * kept so that they could be compared on the same input:
+ * 
+ * - spfa-stack: the original SPFA with stack
+ * - spfa-queue: SPFA with a circular queue
+ * - heap: Dijkstra with an indexed binary heap (default)
+ * - radix: Dijkstra with a radix heap
+ * - bellman-ford: lib/bellman_ford.h, FIFO Bellman-Ford with
+ *   subtree disassembly
+ * 
+ * Negative `c` makes no sense for candies, but the same graph works
+ * for any difference constraints, where the system has no solution
+ * iff there's a negative cycle. Dijkstra fails with negative weights
+ * and spfa-stack would loop forever on a negative cycle. spfa-queue
+ * gives up once a vertex is queued N times, which takes
+ * O(NM), while bellman-ford finds the cycle as soon as it shows up
+ * in the shortest path tree, and prints it to stderr.
+ * 
+ * Pick one by the first command-line argument (e.g. `bin/3159 radix`),
+ * or change the default at compile time with `-DSOLVER=SPFA_STACK`.
+ * 
  */
  
 #include <stdio.h>
 #include <string.h>
 
+#include "lib/fastio.h"
+#include "lib/bellman_ford.h"
+#include "lib/csr.h"
+
+#ifndef SOLVER
+#define SOLVER DIJKSTRA_HEAP
+#endif
+
 #define MAX_N 30001
 #define MAX_E 150001
 
@@ -36,6 +69,7 @@ int head[MAX_N];
 // Each vertex in head[] points to an edge list in edges[],
 // which is linked by `next` attribute.
 struct {
+  int from; // the source of this edge
   int to; // the destination of this edge
   int weight; // the weight of this edge
   int next; // next edge in the linked list
@@ -48,48 +82,97 @@ void add_edge(int from, int to, int weight) {
 
   // Add to the head of related linked list
   edges[num_edges].next = head[from];
+  edges[num_edges].from = from;
   edges[num_edges].to = to;
   edges[num_edges].weight = weight;
 
   head[from] = num_edges++;
 }
 
-// Clear the graph
-void init_graph() {
+// Clear the graph of vertices [0, n].
+//
+// add_edge() sets every field of a new edge, so
+// only the vertices need to be cleared.
+void init_graph(int n) {
   num_edges = 0;
-  memset(head, END, sizeof(head));
-  memset(edges, 0, sizeof(edges));
+  memset(head, END, sizeof(int)*(n+1));
 }
 
 /*
- * SPFA APIs
+ * Frozen graph APIs
+ * 
+ * Once all edges are added, the graph is frozen into compressed
+ * sparse rows, see lib/csr.h.
+ * 
+ * The linked lists are left untouched, so add_edge() and head[]
+ * still work after freezing.
+ */
+
+// offsets[i]: the first out-edge of vertex `i` in targets[].
+int offsets[MAX_N+2];
+// The destination and weight of each edge, sorted by source.
+int targets[MAX_E];
+int weights[MAX_E];
+
+// Store an edge into slot `pos` of targets[] and weights[].
+#define PUT_EDGE(pos, edge) \
+  (targets[pos] = (edge).to, weights[pos] = (edge).weight)
+
+// freeze_graph(n, m): build offsets[], targets[] and weights[]
+// from edges[0..m). Vertices should be in range [0, n].
+DEFINE_CSR_FREEZE(freeze_graph, edges, from, offsets, PUT_EDGE)
+
+/*
+ * Solver APIs
  */
 
 #define INF 0x3f3f3f3f
 
+// Available engines.
+enum solver {
+  SPFA_STACK,
+  SPFA_QUEUE,
+  DIJKSTRA_HEAP,
+  DIJKSTRA_RADIX,
+  BELLMAN_FORD,
+  NUM_SOLVERS,
+};
+
+// Names of engines on the command line,
+// indexed by `enum solver`.
+const char* solver_names[] = {"spfa-stack", "spfa-queue", "heap", "radix", "bellman-ford"};
+
+// DP memory, shared by all engines.
+int distance[MAX_N];
+// visited[i] = 1 if `i` is in the stack/queue (SPFA),
+// or if `i` has been settled (Dijkstra).
+int visited[MAX_N];
+
+// Reset distance[] and visited[] before a run.
+void init_distance(int start, int n) {
+  for (int i = 1; i <= n; i++) {
+    distance[i] = INF;
+    visited[i] = 0;
+  }
+  distance[start] = 0;
+}
+
+/*
+ * SPFA APIs
+ */
+
 // Use stack instead of queue here
 int stack[MAX_N];
-int visited[MAX_N];
 int stack_top = 0;
 
-// DP memory
-int distance[MAX_N];
-
 // SPFA algo.
 void SPFA(int start, int n) {
   stack_top = 0;
 
   // init the stack
-  for (int i = 1; i <= n; i++) {
-    if (i == start) {
-      stack[stack_top++] = i;
-      visited[i] = 1;
-      distance[i] = 0;
-    } else {
-      visited[i] = 0;
-      distance[i] = INF;
-    }
-  }  
+  init_distance(start, n);
+  stack[stack_top++] = start;
+  visited[start] = 1;
 
   // DP with a loop
   while (stack_top) {
@@ -101,10 +184,10 @@ void SPFA(int start, int n) {
     // For each edge starts from this vertex, 
     // update its distance. If a vertex's distance
     // is updated, push it back to stack.
-    for (int i = head[from]; i != END; i = edges[i].next) {
-      int to = edges[i].to;
-      if (distance[to] > distance[from] + edges[i].weight) {
-        distance[to] = distance[from] + edges[i].weight;
+    for (int i = offsets[from]; i < offsets[from+1]; i++) {
+      int to = targets[i];
+      if (distance[to] > distance[from] + weights[i]) {
+        distance[to] = distance[from] + weights[i];
         if (!visited[to]) {
           visited[to] = 1;
           stack[stack_top++] = to;
@@ -114,28 +197,317 @@ void SPFA(int start, int n) {
   }
 }
 
-int main() {
+// The same algo with a circular queue, like POJ 1275.
+// A vertex is in the queue at most once, so MAX_N
+// slots are enough.
+int queue[MAX_N];
+int q_head;
+int q_tail;
+
+// How many times each vertex has been queued.
+int cnt[MAX_N];
+
+// Return 0 if there's a negative cycle.
+int SPFA_queue(int start, int n) {
+  q_head = q_tail = 0;
+
+  // init the queue
+  init_distance(start, n);
+  memset(cnt, 0, sizeof(int)*(n+1));
+  queue[q_head++] = start;
+  visited[start] = 1;
+
+  while (q_head != q_tail) {
+
+    // Pick a vertex out of queue
+    int from = queue[q_tail];
+    q_tail = (q_tail+1) % MAX_N;
+    visited[from] = 0;
+
+    for (int i = offsets[from]; i < offsets[from+1]; i++) {
+      int to = targets[i];
+      if (distance[to] > distance[from] + weights[i]) {
+        distance[to] = distance[from] + weights[i];
+        if (!visited[to]) {
+          visited[to] = 1;
+          queue[q_head] = to;
+          q_head = (q_head+1) % MAX_N;
+
+          // In FIFO order, each pass of Bellman-Ford queues a
+          // vertex at most once, and there are at most n-1
+          // passes without a negative cycle.
+          if (++cnt[to] >= n) return 0;
+        }
+      }
+    }
+  }
+
+  return 1;
+}
+
+/*
+ * Indexed binary heap APIs
+ * 
+ * A min-heap of vertices keyed by distance[]. Since heap_pos[]
+ * records where each vertex locates in the heap, we could
+ * decrease the key of a vertex in place instead of pushing
+ * a duplicate, so the heap never holds more than n vertices.
+ */
+
+// heap[1..heap_size]: vertices in the heap.
+int heap[MAX_N];
+int heap_size;
+// heap_pos[i]: the index of vertex `i` in heap[], 0 if absent.
+int heap_pos[MAX_N];
+
+// Move heap[pos] up until its parent is not larger.
+void heap_sift_up(int pos) {
+  int x = heap[pos];
+  while (pos > 1 && distance[heap[pos/2]] > distance[x]) {
+    heap[pos] = heap[pos/2];
+    heap_pos[heap[pos]] = pos;
+    pos /= 2;
+  }
+  heap[pos] = x;
+  heap_pos[x] = pos;
+}
+
+// Move heap[pos] down until its children are not smaller.
+void heap_sift_down(int pos) {
+  int x = heap[pos];
+  while (pos*2 <= heap_size) {
+    int child = pos*2;
+    if (child < heap_size && distance[heap[child+1]] < distance[heap[child]])
+      child++;
+    if (distance[heap[child]] >= distance[x]) break;
+    heap[pos] = heap[child];
+    heap_pos[heap[pos]] = pos;
+    pos = child;
+  }
+  heap[pos] = x;
+  heap_pos[x] = pos;
+}
+
+// Insert `x`, or decrease its key if it is already in the heap.
+// distance[x] should have been updated by the caller.
+void heap_push(int x) {
+  if (!heap_pos[x]) {
+    heap[++heap_size] = x;
+    heap_pos[x] = heap_size;
+  }
+  heap_sift_up(heap_pos[x]);
+}
+
+// Pop the vertex with minimum distance.
+int heap_pop() {
+  int top = heap[1];
+  heap_pos[top] = 0;
+  if (--heap_size) {
+    heap[1] = heap[heap_size+1];
+    heap_sift_down(1);
+  }
+  return top;
+}
+
+void dijkstra_heap(int start, int n) {
+  heap_size = 0;
+  memset(heap_pos, 0, sizeof(int)*(n+1));
+
+  init_distance(start, n);
+  heap_push(start);
+
+  while (heap_size) {
+
+    // The vertex with minimum distance is settled.
+    int from = heap_pop();
+    visited[from] = 1;
+
+    for (int i = offsets[from]; i < offsets[from+1]; i++) {
+      int to = targets[i];
+      if (!visited[to] && distance[to] > distance[from] + weights[i]) {
+        distance[to] = distance[from] + weights[i];
+        heap_push(to);
+      }
+    }
+  }
+}
+
+/*
+ * Radix heap APIs
+ * 
+ * Dijkstra pops keys in non-decreasing order, so a radix heap
+ * could be used: an item with key `k` is kept in bucket
+ * `bit_width(k ^ last)`, where `last` is the key popped last time.
+ * When bucket 0 runs out, the smallest non-empty bucket is
+ * redistributed around its minimum key, and each item moves to
+ * a strictly lower bucket, so it's moved at most 32 times.
+ * 
+ * Stale items are skipped on pop instead of being deleted. Every
+ * edge is relaxed at most once after its source is settled, so
+ * there are at most MAX_E + 1 items pushed in total, and items
+ * could be allocated from a pool without being recycled.
+ */
+
+#define NUM_BUCKETS 33
+
+// Each bucket is a linked list of items in the pool.
+struct {
+  unsigned key;
+  int vertex;
+  int next;
+} radix_pool[MAX_E+1];
+int radix_pool_size;
+int bucket_head[NUM_BUCKETS];
+// The key popped last time.
+unsigned radix_last;
+// Number of items in all buckets.
+int radix_size;
+
+// The bucket an item with key `key` belongs to.
+int radix_bucket(unsigned key) {
+  return key == radix_last ? 0 : 32 - __builtin_clz(key ^ radix_last);
+}
+
+// Insert an item into a bucket.
+void radix_link(int item) {
+  int b = radix_bucket(radix_pool[item].key);
+  radix_pool[item].next = bucket_head[b];
+  bucket_head[b] = item;
+}
+
+void radix_push(unsigned key, int vertex) {
+  radix_pool[radix_pool_size].key = key;
+  radix_pool[radix_pool_size].vertex = vertex;
+  radix_link(radix_pool_size++);
+  radix_size++;
+}
+
+// Pop an item with minimum key, return its vertex.
+int radix_pop() {
+  if (bucket_head[0] == END) {
+
+    // Find the smallest non-empty bucket and its minimum key.
+    int b = 1;
+    while (bucket_head[b] == END) b++;
+    radix_last = radix_pool[bucket_head[b]].key;
+    for (int i = bucket_head[b]; i != END; i = radix_pool[i].next)
+      if (radix_pool[i].key < radix_last) radix_last = radix_pool[i].key;
+
+    // Redistribute the items around the new `radix_last`.
+    int i = bucket_head[b];
+    bucket_head[b] = END;
+    while (i != END) {
+      int next = radix_pool[i].next;
+      radix_link(i);
+      i = next;
+    }
+  }
+
+  int item = bucket_head[0];
+  bucket_head[0] = radix_pool[item].next;
+  radix_size--;
+  return radix_pool[item].vertex;
+}
+
+void dijkstra_radix(int start, int n) {
+  radix_pool_size = radix_size = 0;
+  radix_last = 0;
+  memset(bucket_head, END, sizeof(bucket_head));
+
+  init_distance(start, n);
+  radix_push(0, start);
+
+  while (radix_size) {
+
+    // Skip stale items of settled vertices.
+    int from = radix_pop();
+    if (visited[from]) continue;
+    visited[from] = 1;
+
+    for (int i = offsets[from]; i < offsets[from+1]; i++) {
+      int to = targets[i];
+      if (!visited[to] && distance[to] > distance[from] + weights[i]) {
+        distance[to] = distance[from] + weights[i];
+        radix_push(distance[to], to);
+      }
+    }
+  }
+}
+
+/*
+ * Bellman-Ford APIs
+ */
+
+struct bellman_ford bf;
+int bf_work[BF_WORK_SIZE(MAX_N)];
+// The negative cycle found
+int cycle[MAX_N];
+
+int bellman_ford(int start, int n) {
+  bf_init(&bf, n, offsets, targets, weights, distance, bf_work);
+  bf_clear(&bf);
+  bf_root(&bf, start, 0, 1);
+  return bf_run(&bf);
+}
+
+// Run the engine `mode` from `start`. Return 0 if
+// it found a negative cycle.
+int solve(int mode, int start, int n) {
+  switch (mode) {
+    case SPFA_STACK: SPFA(start, n); return 1;
+    case SPFA_QUEUE: return SPFA_queue(start, n);
+    case DIJKSTRA_HEAP: dijkstra_heap(start, n); return 1;
+    case DIJKSTRA_RADIX: dijkstra_radix(start, n); return 1;
+    default: return bellman_ford(start, n);
+  }
+}
+
+int main(int argc, char** argv) {
+
+  // Pick the engine
+  int mode = SOLVER;
+  if (argc > 1) {
+    for (mode = 0; mode < NUM_SOLVERS; mode++)
+      if (!strcmp(argv[1], solver_names[mode])) break;
+    if (mode == NUM_SOLVERS) {
+      fprintf(stderr, "usage: %s [spfa-stack|spfa-queue|heap|radix|bellman-ford]\n", argv[0]);
+      return 1;
+    }
+  }
 
   // Get the size of input
   int N, M;
-  scanf("%d%d", &N, &M);
+  read_int(&N), read_int(&M);
 
   // Init the graph
-  init_graph();
+  init_graph(N);
   
   // Get all constraints and construct a graph out of them
   for (int i = 0; i < M; i++) {
     int A, B, c;
-    scanf("%d%d%d", &A, &B, &c);
+    read_int(&A), read_int(&B), read_int(&c);
 
     // The problem requires B-A <= c, which is equivalent
     // to B <= A + c, so c should be the weight.
     add_edge(A, B, c);
   }
 
-  // Use SPFA to solve this problem.
-  SPFA(1, N);
-  printf("%d\n", distance[N]);
+  // All edges are added, lay them out for the solvers.
+  freeze_graph(N, num_edges);
+
+  // Find the shortest path with the chosen engine.
+  if (solve(mode, 1, N)) printf("%d\n", distance[N]);
+  else {
+    printf("No Solution\n");
+
+    // Show the constraints that contradict each other.
+    if (mode == BELLMAN_FORD) {
+      int len = bf_cycle(&bf, cycle);
+      fprintf(stderr, "negative cycle:");
+      for (int i = 0; i < len; i++) fprintf(stderr, " %d", cycle[i]);
+      fprintf(stderr, "\n");
+    }
+  }
 
   return 0;
 }
\ No newline at end of file
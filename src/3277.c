@@ -23,22 +23,47 @@
  * tree of all serials, so the size of segment tree would not be
  * larger than 1000000000*40000 space units, which is acceptable.
  * 
+ * The tree still takes 8 nodes per building, and is visited in a
+ * pointer-chasing order. For horizons of millions of buildings there
+ * is a sweep engine as well: each building turns into two events,
+ * rising at A and falling at B, which are radix sorted by x axis and
+ * swept from left to right. A max-heap keeps the heights of the
+ * buildings over the sweep line, and a falling building is not
+ * removed from it right away, but put into a second heap of dead
+ * heights, which are popped together once they reach the top. The
+ * horizon between two adjacent x axises is the top of the heap.
+ * No tree is built, and all arrays are accessed sequentially except
+ * the heaps.
+ * 
+ * Pick the engine by the first command-line argument:
+ * 
+ * - sweep: the sweep engine (default), no limit on buildings
+ * - tree: the segment tree engine, up to MAX_N-1 buildings
+ * 
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "lib/fastio.h"
+#include "lib/radix_sort.h"
+
+#ifndef MAX_N
 #define MAX_N 50000
+#endif
 
-// Use an array to map the range in segment tree
-// to x axises.
-long long map[MAX_N*2];
-// Record the height of each building.
-long long height[MAX_N];
+// Engines
+enum engine {
+  SWEEP,
+  TREE,
+};
 
-int cmp(const void* a, const void* b) {
-  return *((long long*)a) - *((long long*)b);
-}
+// Use an array to map the range in segment tree
+// to x axises, and a buffer to sort it.
+long long map[MAX_N*2], map_tmp[MAX_N*2];
+// Record each building.
+long long l_axis[MAX_N], r_axis[MAX_N], height[MAX_N];
 
 // Self-implemented unique() based on Cpp reference.
 long long* unique(long long *first, long long* last) {
@@ -140,22 +165,121 @@ long long solve(int height, int root) {
   return solve(seg_tree[root].height, root*2) + solve(seg_tree[root].height, root*2+1);
 }
 
-int main() {
+/*
+ * Sweep APIs
+ */
+
+// A building rises at x axis `key` with height
+// `value` > 0, and falls at `key` with -height.
+typedef struct radix_pair64 event;
+
+// A max-heap of heights.
+typedef struct {
+  long long* body;
+  int size;
+} heap;
+
+void heap_push(heap* h, long long value) {
+  int i = h->size++;
+  while (i > 0 && h->body[(i-1)/2] < value) {
+    h->body[i] = h->body[(i-1)/2];
+    i = (i-1)/2;
+  }
+  h->body[i] = value;
+}
+
+void heap_pop(heap* h) {
+  long long last = h->body[--h->size];
+  int i = 0;
+  while (i*2+1 < h->size) {
+    int child = i*2+1;
+    if (child+1 < h->size && h->body[child+1] > h->body[child]) child++;
+    if (h->body[child] <= last) break;
+    h->body[i] = h->body[child];
+    i = child;
+  }
+  h->body[i] = last;
+}
+
+// Sum the area of `n` buildings from the input
+// with the sweep engine.
+long long sweep(int n) {
+  event* events = malloc(sizeof(event) * n * 2);
+  event* tmp = malloc(sizeof(event) * n * 2);
+
+  for (int i = 0; i < n; i++) {
+    long long a, b, h;
+    read_long(&a), read_long(&b), read_long(&h);
+    events[i*2] = (event){a, h};
+    events[i*2+1] = (event){b, -h};
+  }
+  radix_sort_pairs64(events, tmp, n*2);
+  free(tmp);
+
+  heap alive = {malloc(sizeof(long long) * n), 0};
+  heap dead = {malloc(sizeof(long long) * n), 0};
+
+  long long area = 0;
+  for (int i = 0; i < n*2; ) {
+
+    // Apply all events on this x axis.
+    unsigned long long x = events[i].key;
+    for (; i < n*2 && events[i].key == x; i++) {
+      if (events[i].value > 0) heap_push(&alive, events[i].value);
+      else heap_push(&dead, -events[i].value);
+    }
+
+    // Drop dead heights from the top.
+    while (alive.size && dead.size && alive.body[0] == dead.body[0]) {
+      heap_pop(&alive);
+      heap_pop(&dead);
+    }
+
+    // The horizon holds until the next x axis.
+    if (i < n*2 && alive.size)
+      area += (long long)(events[i].key - x) * alive.body[0];
+  }
+
+  free(events);
+  free(alive.body), free(dead.body);
+  return area;
+}
+
+int main(int argc, char** argv) {
+
+  // Pick the engine
+  int mode = SWEEP;
+  if (argc > 1) {
+    if (!strcmp(argv[1], "sweep")) mode = SWEEP;
+    else if (!strcmp(argv[1], "tree")) mode = TREE;
+    else {
+      fprintf(stderr, "usage: %s [sweep|tree]\n", argv[0]);
+      return 1;
+    }
+  }
 
   int n; // Number of inputs
   int ptr = 0; // Temporary variable to help discretization
-  long long l_axis[MAX_N], r_axis[MAX_N];
+
+  read_int(&n);
+  if (mode == SWEEP) {
+    printf("%lld\n", sweep(n));
+    return 0;
+  }
+  if (n >= MAX_N) {
+    fprintf(stderr, "%d buildings are too many for the tree engine (< %d)\n", n, MAX_N);
+    return 1;
+  }
 
   // Get all inputs and discretize them.
-  scanf("%d", &n);
   for (int i = 1; i <= n; i++) {
-    scanf("%d%d%d", &l_axis[i], &r_axis[i], &height[i]);
+    read_long(&l_axis[i]), read_long(&r_axis[i]), read_long(&height[i]);
     map[++ptr] = l_axis[i];
     map[++ptr] = r_axis[i];
   }
 
-  // Sort all x axises.
-  qsort((void*)(map+1), ptr, sizeof(long long), cmp);
+  // Sort all x axises, which are never negative.
+  radix_sort_u64((unsigned long long*)(map+1), (unsigned long long*)map_tmp, ptr);
 
   // Sift out repeated axises to optimize the size
   // of segmented tree.
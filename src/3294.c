@@ -41,134 +41,97 @@
  * 3. Build the height array of `str` by the suffix array (height
  *    array is the array recording the length of longest common
  *    prefix of two adjacent suffixes in the sorted array).
- * 4. From 0 to MAX_LEN, try the longest possible length of common substring
- *    using a binary search. We may judge if a length `len` is possible
+ * 4. From 0 to the longest input, try the longest possible length of
+ *    common substring using a binary search. We may judge if a length `len` is possible
  *    by checking if there is a common prefix with length `len` between
  *    a set of sorted suffixes, and head elements of these suffixes
  *    cover more than a half of inputted strings.
  * 5. As we have found the longest length, we may print all common
  *    substrings with this length in order.
  * 
+ * Each separator should be a character not in any input string and
+ * different from all other separators. There are only 127 chars
+ * beyond the alphabet, so `str` is made of ints instead: letters are
+ * 1..26 and separators count up from 27, for any number of strings.
+ * Strings are read char by char into buffers that grow with the
+ * input, so there's no limit on their number or length either.
+ * 
  */ 
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-#define MAX_N 101
-#define MAX_LEN 1001
-#define ARR_SIZE (MAX_N*MAX_LEN)
-
-// A simple swap function
-void swap(int** x, int** y) {
-  int *tmp = *x;
-  *x = *y;
-  *y = tmp;
-}
+#include "lib/fastio.h"
+#include "lib/suffix_array.h"
 
 /*
  * Suffix Array API
  */
 
+// The suffix array of `str`, see lib/suffix_array.h.
+// It owns its buffers, which grow with the input by
+// sa_reserve(), so there's no limit on the length of `str`.
+struct suffix_array sa;
+
 // suffix: suffix array
 // 
 // Both suffix[i] = j and rank[j] = i indicates that
 // the `i`th suffix in the sorted array is `j`.
-int suffix[ARR_SIZE];
-int rank[ARR_SIZE];
-
+//
 // height[i]: length of the longest common prefix
-// between rank[i] and rank[i-1].
-int height[ARR_SIZE];
-
-// We use two keys iteratively in doubling process.
-int fst_buf[ARR_SIZE], snd_buf[ARR_SIZE];
-// Use bucket sort to reduce time complexity.
-int bucket[ARR_SIZE];
+// between suffix[i] and suffix[i-1].
+//
+// Both of them point to the buffers of `sa`.
+int *suffix, *height;
 
 // Build suffix[], rank[] and height[] in this function.
 // 
 // @param str: the string to build sa
 // @param len: length of string
 // @param range: possible range of characters in `str`.
-//
-// This version of implementation is based on doubling algorithm
-// and bucket sort, so the time complexity is reduced to O(NlogN).
-void init_suffix_array(char* str, int len, int range) {
-
-  // We need to swap fst_key and snd_key later,
-  // but the array's head pointer is readonly,
-  // so a transformation is necessary here.
-  int *fst_key = fst_buf;
-  int *snd_key = snd_buf;
-
-  // Init the bucket
-  for (int i = 0; i < range; i++) bucket[i] = 0;
-
-  // Set the first key
-  for (int i = 0; i < len; i++) {
-    fst_key[i]=str[i];
-    ++bucket[str[i]];
-  }
-
-  // Bucket sort on suffix[] based on the first key
-  for (int i = 1; i < range; i++) bucket[i] += bucket[i-1];
-  for (int i = len-1; i >= 0; i--) suffix[--bucket[fst_key[i]]] = i;
+void init_suffix_array(int* str, int len, int range) {
 
-  // Use a temporary value `p` to store the next
-  // serial to be assigned.
-  int p = 1;
-
-  // Doubling period.
-  // `j` is the doubling step.
-  for (int j = 1; p < len; j *= 2) {
-    p = 0;
-
-    // Handle the gap between n*j and len.
-    // This part of value do not have the second key.
-    for (int i = len-j; i < len; i++) snd_key[p++] = i;
-
-    // Calculate all `snd_key`s.
-    for (int i = 0; i < len; i++)
-      if (suffix[i] >= j) snd_key[p++] = suffix[i]-j;
-    
-    // Bucket sort based on fst_key and snd_key.
-    for (int i = 0; i < range; i++) bucket[i] = 0;
-    for (int i = 0; i < len; i++) ++bucket[fst_key[snd_key[i]]];
-    for (int i = 1; i < range; i++) bucket[i] += bucket[i-1];
-    for (int i = len-1; i >= 0; i--) suffix[--bucket[fst_key[snd_key[i]]]] = snd_key[i];
-
-    // Iterate: generate new fst_key
-    swap(&fst_key, &snd_key);
-    fst_key[suffix[0]] = 0; 
-    p = 1;
-    for (int i = 1; i < len; i++)
-      if (snd_key[suffix[i]] == snd_key[suffix[i-1]] &&
-          snd_key[suffix[i]+j] == snd_key[suffix[i-1]+j])
-        fst_key[suffix[i]] = p-1;
-      else fst_key[suffix[i]] = p++;
-
-    // The range of serials has updated
-    range = p;
-  }
- 
-  // Build rank[] and height[]
-  for (int i = 1; i < len; i++) rank[suffix[i]] = i;
-  p = 0;
-  for (int i = 0; i < len-1; height[rank[i++]] = p) {
-    if (p) --p;
-    for (int j = suffix[rank[i]-1]; str[i+p] == str[j+p]; p++) ;
-  }
+  sa_reserve(&sa, len);
+  sa_build_int(&sa, str, len, range);
+  suffix = sa.suffix;
+  height = sa.height;
 }
 
 /*
  * Relevant to the question
  */
 
-// belong[i] is the serial of the string containing `i`. 
-int belong[ARR_SIZE];
-// Inputs
-int n, str_len;
-char str[ARR_SIZE];
+// Inputs: `n` strings concatenated into str[], and belong[i]
+// is the serial of the string containing `i`. Both of them
+// hold `capacity` ints, and grow with the input.
+int n, str_len, capacity;
+int *str, *belong;
+
+// Make room for `len` chars in str[] and belong[].
+void reserve(int len) {
+  if (len <= capacity) return;
+  capacity = len > 2*capacity ? len : 2*capacity;
+  str = realloc(str, sizeof(int)*capacity);
+  belong = realloc(belong, sizeof(int)*capacity);
+}
+
+// visited[k] == stamp if string `k` has been matched by the
+// current group of suffixes. Each group takes a new stamp,
+// so there's no need to clear n strings for every group.
+int* visited;
+int visited_capacity, stamp;
+
+// Clear visited[] for `n` strings.
+void init_visited(int n) {
+  if (n > visited_capacity) {
+    visited_capacity = n > 2*visited_capacity ? n : 2*visited_capacity;
+    free(visited);
+    visited = malloc(sizeof(int)*visited_capacity);
+  }
+  memset(visited, 0, sizeof(int)*n);
+  stamp = 0;
+}
 
 // Returns 1 if there exists any possible common substring
 // with length `len`, 0 elsewise.
@@ -177,7 +140,7 @@ int check(int len) {
   // Record the appearance of current picked
   // prefix in all suffixes.
   int match_cnt = 0;
-  char visited[MAX_N] = {0};
+  stamp++;
 
   for (int i = 2; i < str_len; i++) {
     
@@ -195,12 +158,12 @@ int check(int len) {
       //
       // Note that each suffix[i] represents the location
       // of an element in `str`.
-      if (visited[belong[suffix[i]]] == 0) {
-        visited[belong[suffix[i]]] = 1;
+      if (visited[belong[suffix[i]]] != stamp) {
+        visited[belong[suffix[i]]] = stamp;
         match_cnt++;
       }
-      if (visited[belong[suffix[i-1]]] == 0) {
-        visited[belong[suffix[i-1]]] = 1;
+      if (visited[belong[suffix[i-1]]] != stamp) {
+        visited[belong[suffix[i-1]]] = stamp;
         match_cnt++;
       }
     } else {
@@ -211,8 +174,8 @@ int check(int len) {
       if (match_cnt > n/2) return 1;
 
       // Current common prefix is not satisfying,
-      // so clear the match record to find a new one.
-      memset(visited, 0, sizeof(visited));
+      // so start a new match record to find a new one.
+      stamp++;
       match_cnt = 0;
     }
   }
@@ -228,7 +191,7 @@ void print(int len) {
   // Record the appearance of current picked
   // prefix in all suffixes.
   int match_cnt = 0, match_base;
-  char visited[MAX_N] = {0};
+  stamp++;
 
   for (int i = 2; i <= str_len; i++) {
     if (height[i] >= len) {
@@ -237,12 +200,12 @@ void print(int len) {
       // common substring.
       match_base = suffix[i];
 
-      if (visited[belong[suffix[i]]] == 0) {
-        visited[belong[suffix[i]]] = 1;
+      if (visited[belong[suffix[i]]] != stamp) {
+        visited[belong[suffix[i]]] = stamp;
         match_cnt++;
       }
-      if (visited[belong[suffix[i-1]]] == 0) {
-        visited[belong[suffix[i-1]]] = 1;
+      if (visited[belong[suffix[i-1]]] != stamp) {
+        visited[belong[suffix[i-1]]] = stamp;
         match_cnt++;
       }
     } else {
@@ -260,8 +223,8 @@ void print(int len) {
       }
 
       // Current common prefix is not satisfying,
-      // so clear the match record to find a new one.
-      memset(visited, 0, sizeof(visited));
+      // so start a new match record to find a new one.
+      stamp++;
       match_cnt = 0;
     }
   }
@@ -270,42 +233,47 @@ void print(int len) {
 
 int main() {
 
-  // Use a temporary array to store each
-  // inputted string.
-  char tmp_str[MAX_LEN];
   int l, r;
 
-  while (scanf("%d", &n) != 0 && n) {
+  while (read_int(&n) && n) {
 
     // Concatenate all inputed strings into `str`,
     // splitting by characters not in inputed strings.
     str_len = 0;
+    int max_len = 0;
     for (int i = 0; i < n; i++) {
 
-      // Get an input string and copy it to `str`.
-      scanf("%s", tmp_str);
-      for (int j = 0; tmp_str[j] != 0; j++) {
+      // Stream an input string into `str`.
+      char c;
+      int start = str_len;
+      io_skip_space();
+      while (read_token_char(&c)) {
+        reserve(str_len+1);
 
         // Set the belongingness of each character
-        belong[str_len] = i; 
+        belong[str_len] = i;
 
         // We need to shift all characters to the position
-        // started by 1 as the bucket sort requires. 
-        str[str_len++] = tmp_str[j]-'a'+1;
+        // started by 1 as the bucket sort requires.
+        str[str_len++] = c-'a'+1;
       }
+      if (str_len - start > max_len) max_len = str_len - start;
 
       // The alphabet ends at 'z' (26 after the shift),
       // so we start the value of padding character by 27.
+      reserve(str_len+1);
+      belong[str_len] = i;
       str[str_len++] = 27+i;
     }
     str[str_len-1] = 0;
 
     // Set suffix[], rank[] and height[].
-    init_suffix_array(str, str_len, 127);
+    init_suffix_array(str, str_len, 27+n);
+    init_visited(n);
 
     // Use a binary search based on check()
     // to find the longest common substring.
-    l = 0, r = MAX_LEN;
+    l = 0, r = max_len;
     while (l < r) {
       int mid = (l+r+1)/2;
       if (check(mid)) l = mid;
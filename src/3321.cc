@@ -16,22 +16,68 @@
  * just for a quiz, so I wrote my solution in C++ (C with
  * class, strictly speaking).
  * 
+ * A vector per fork means up to 100k heap allocations, so the
+ * branches are read into a flat array and counting sorted into
+ * one array of children by parent (CSR) instead, in the same
+ * order as they came.
+ * 
+ * With millions of operations, each one walking the BIT on its own
+ * adds up. The batch engine keeps apples as a bitset in Euler order,
+ * and the BIT only counts apples in blocks of 64 forks, so it's 64
+ * times smaller and stays in cache along with the bitset; the part of
+ * a prefix sum inside a block is a popcount. Runs of changes are
+ * coalesced:
+ * 
+ * - forks changed an even number of times in a run are left alone,
+ *   and the others are changed once when the run ends;
+ * - a query flushes the pending changes first, and is answered right
+ *   away. The whole structure fits in L1 cache, so answering a run
+ *   of queries in the order of their Euler positions doesn't pay for
+ *   sorting them.
+ * 
+ * Pick the engine by the first command-line argument:
+ * 
+ * - batch: the batch engine (default)
+ * - single: one operation at a time on the plain BIT
+ * 
  */
 
 #include <cstdio>
-#include <vector>
-using std::vector;
+#include <cstring>
+
+#include "lib/fastio.h"
+#include "lib/csr.h"
 
 #define MAX_N 100001
 
 // LST(x) is the lowest 1 in x's binary representation.
 #define LST(x) ((x) & (-(x)))
 
-// Define a 2-dim array to store the relations
-// of branches inputed.
-//
-// tree[i][j]: fork `i` and fork `j` are connected by a branch.
-vector<vector<int>> tree(MAX_N);
+// Forks in a block of the batch engine.
+#define BLOCK 64
+#define MAX_BLOCKS (MAX_N/BLOCK + 1)
+
+// Engines
+enum engine {
+  BATCH,
+  SINGLE,
+};
+
+// Branches inputted, from fork `parent` to fork `child`.
+struct {
+  int parent, child;
+} branches[MAX_N];
+
+// Subforks of fork `i` are children[offsets[i]..offsets[i+1]).
+int offsets[MAX_N+2];
+int children[MAX_N];
+
+// Store a branch into slot `pos` of children[].
+#define PUT_BRANCH(pos, branch) (children[pos] = (branch).child)
+
+// freeze_tree(n, m): build offsets[] and children[] from the
+// `m` branches starting at branches[1], see lib/csr.h.
+DEFINE_CSR_FREEZE(freeze_tree, branches+1, parent, offsets, PUT_BRANCH)
 
 // The binary indexed tree (BIT).
 int binary_indexed_tree[MAX_N];
@@ -46,19 +92,43 @@ int end[MAX_N];
 // pos_ptr helps transform the tree form of forks to range form.
 int pos_ptr;
 
-// This recursive function transforms the tree form of forks
+// The explicit stack of DFS.
+//
+// dfs_stack[i] is a fork on the path from root, and
+// children[dfs_next[i]] is the next subfork of it to visit.
+int dfs_stack[MAX_N];
+int dfs_next[MAX_N];
+
+// This function transforms the tree form of forks
 // to range form, making it easier to be maintained by BIT.
-void tree_to_range(int fork) {
-
-  // Mark the start position of `fork`
-  start[fork] = pos_ptr;
-  // Transform each subfork.
-  for (int i = 0; i < tree[fork].size(); i++) {
-    pos_ptr++;
-    tree_to_range(tree[fork][i]);
+//
+// It used to be recursive, which overflows the stack on
+// path-shaped trees with 100k forks, so an explicit stack
+// is used instead. The order of visits is not changed.
+void tree_to_range(int root) {
+  int top = 0;
+
+  // Mark the start position of `root`
+  start[root] = pos_ptr;
+  dfs_stack[top] = root;
+  dfs_next[top++] = offsets[root];
+
+  while (top) {
+    int fork = dfs_stack[top-1];
+
+    // Transform the next subfork.
+    if (dfs_next[top-1] < offsets[fork+1]) {
+      int sub = children[dfs_next[top-1]++];
+      start[sub] = ++pos_ptr;
+      dfs_stack[top] = sub;
+      dfs_next[top++] = offsets[sub];
+
+    // All subforks are done, mark the end position of `fork`
+    } else {
+      end[fork] = pos_ptr;
+      top--;
+    }
   }
-  // Mark the end position of `fork`
-  end[fork] = pos_ptr;
 }
 
 // Update the BIT by adding `x` to `BIT[pos]`
@@ -88,24 +158,123 @@ int bit_query(int pos) {
   return sum;
 }
 
-int main() {
+/*
+ * Batch engine
+ */
+
+// Bit `p` is set if there is an apple on the fork
+// at Euler position `p`.
+unsigned long long apple_bits[MAX_BLOCKS];
+// The BIT over the number of apples in each block,
+// block `b` (from 0) is at `b+1`.
+int block_bit[MAX_BLOCKS+1];
+int num_blocks;
+
+// The state of fork `x` in the current run of changes:
+// 0 if it's not changed, 1 if it's changed an odd number
+// of times, 2 if it's changed an even number of times.
+char changed[MAX_N];
+// Forks changed in the current run.
+int changed_forks[MAX_N];
+int num_changed;
+
+// Put an apple on every fork.
+void init_blocks(int n) {
+  num_blocks = (n+1) / BLOCK + 1;
+  for (int p = 1; p <= n; p++) apple_bits[p / BLOCK] |= 1ULL << (p % BLOCK);
+
+  // Linear BIT construction: add each node to its parent.
+  for (int b = 1; b <= num_blocks; b++) {
+    block_bit[b] += __builtin_popcountll(apple_bits[b-1]);
+    if (b + LST(b) <= num_blocks) block_bit[b + LST(b)] += block_bit[b];
+  }
+}
+
+// Change the fork at Euler position `p`.
+void toggle_position(int p) {
+  unsigned long long bit = 1ULL << (p % BLOCK);
+  apple_bits[p / BLOCK] ^= bit;
+  int delta = apple_bits[p / BLOCK] & bit ? 1 : -1;
+  for (int b = p / BLOCK + 1; b <= num_blocks; b += LST(b))
+    block_bit[b] += delta;
+}
+
+// The number of apples at Euler positions not greater than `p`.
+int prefix_apples(int p) {
+  int sum = __builtin_popcountll(apple_bits[p / BLOCK] & (~0ULL >> (BLOCK-1 - p % BLOCK)));
+  for (int b = p / BLOCK; b > 0; b -= LST(b))
+    sum += block_bit[b];
+  return sum;
+}
+
+// Apply the forks changed an odd number of times.
+void flush_changes() {
+  for (int i = 0; i < num_changed; i++) {
+    int x = changed_forks[i];
+    if (changed[x] == 1) toggle_position(start[x]);
+    changed[x] = 0;
+  }
+  num_changed = 0;
+}
+
+// Handle `m` operations from the input.
+void batch_operations(int m) {
+  char ope;
+  int x;
+  for (int i = 0; i < m; i++) {
+    read_char(&ope), read_int(&x);
+
+    // Record the change until the run ends.
+    if (ope == 'C') {
+      if (!changed[x]) changed_forks[num_changed++] = x;
+      changed[x] = changed[x] == 1 ? 2 : 1;
+
+    // The run of changes ends here.
+    } else {
+      if (num_changed) flush_changes();
+      write_int(prefix_apples(end[x]) - prefix_apples(start[x]-1));
+      write_char('\n');
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+
+  // Pick the engine
+  int mode = BATCH;
+  if (argc > 1) {
+    if (!strcmp(argv[1], "batch")) mode = BATCH;
+    else if (!strcmp(argv[1], "single")) mode = SINGLE;
+    else {
+      fprintf(stderr, "usage: %s [batch|single]\n", argv[0]);
+      return 1;
+    }
+  }
 
   // All variables to be inputted defined in
   // the question.
-  int N, M, u, v, x;
+  int N, M, x;
   char ope;
 
   // Build the tree defined by the input.
-  scanf("%d", &N);
+  read_int(&N);
   for (int i = 1; i < N; i++) {
-    scanf("%d%d", &u, &v);
-    tree[u].push_back(v);
+    read_int(&branches[i].parent), read_int(&branches[i].child);
   }
+  freeze_tree(N, N-1);
 
   // Transform the tree to range form.
   pos_ptr = 1;
   tree_to_range(1);
 
+  read_int(&M);
+  if (mode == BATCH) {
+    init_blocks(N);
+    batch_operations(M);
+    flush_output();
+    return 0;
+  }
+
   // Construct the BIT
   for (int i = 1; i <= N; i++) {
     bit_update(start[i], N, 1);
@@ -113,9 +282,8 @@ int main() {
   }
 
   // Operations
-  scanf("%d", &M);
   for (int i = 0; i < M; i++) {
-    scanf(" %c%d", &ope, &x);
+    read_char(&ope), read_int(&x);
 
     // Change the state of fork x,
     // and update the BIT.
@@ -130,9 +298,11 @@ int main() {
     
     // Query the BIT
     } else {
-      printf("%d\n", bit_query(end[x]) - bit_query(start[x]-1));
+      write_int(bit_query(end[x]) - bit_query(start[x]-1));
+      write_char('\n');
     }
   }
 
+  flush_output();
   return 0;
 }
\ No newline at end of file
@@ -21,123 +21,60 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 
-#define ARR_SIZE 200002
+#include "lib/fastio.h"
+#include "lib/suffix_array.h"
 
 /*
  * Suffix Array API
  */
 
-// A simple swap function
-void swap(int** x, int** y) {
-  int *tmp = *x;
-  *x = *y;
-  *y = tmp;
-}
+// The suffix array of `str`, see lib/suffix_array.h.
+// It owns its buffers, which grow with the input by
+// sa_reserve(), so there's no limit on the length of `str`.
+struct suffix_array sa;
 
 // suffix: suffix array
 // 
 // Both suffix[i] = j and rank[j] = i indicates that
 // the `i`th suffix in the sorted array is `j`.
-int suffix[ARR_SIZE];
-int rank[ARR_SIZE];
-
+//
 // height[i]: length of the longest common prefix
-// between rank[i] and rank[i-1].
-int height[ARR_SIZE];
-
-// We use two keys iteratively in doubling process.
-int fst_buf[ARR_SIZE], snd_buf[ARR_SIZE];
-// Use bucket sort to reduce time complexity.
-int bucket[ARR_SIZE];
+// between suffix[i] and suffix[i-1].
+//
+// Both of them point to the buffers of `sa`.
+int *suffix, *height;
 
 // Build suffix[], rank[] and height[] in this function.
 // 
 // @param str: the string to build sa
 // @param len: length of string
 // @param range: possible range of characters in `str`.
-//
-// This version of implementation is based on doubling algorithm
-// and bucket sort, so the time complexity is reduced to O(NlogN).
 void init_suffix_array(char* str, int len, int range) {
 
-  // We need to swap fst_key and snd_key later,
-  // but the array's head pointer is readonly,
-  // so a transformation is necessary here.
-  int *fst_key = fst_buf;
-  int *snd_key = snd_buf;
-
-  // Init the bucket
-  for (int i = 0; i < range; i++) bucket[i] = 0;
-
-  // Set the first key
-  for (int i = 0; i < len; i++) {
-    fst_key[i]=str[i];
-    ++bucket[str[i]];
-  }
-
-  // Bucket sort on suffix[] based on the first key
-  for (int i = 1; i < range; i++) bucket[i] += bucket[i-1];
-  for (int i = len-1; i >= 0; i--) suffix[--bucket[fst_key[i]]] = i;
-
-  // Use a temporary value `p` to store the next
-  // serial to be assigned.
-  int p = 1;
-
-  // Doubling period.
-  // `j` is the doubling step.
-  for (int j = 1; p < len; j *= 2) {
-    p = 0;
-
-    // Handle the gap between n*j and len.
-    // This part of value do not have the second key.
-    for (int i = len-j; i < len; i++) snd_key[p++] = i;
-
-    // Calculate all `snd_key`s.
-    for (int i = 0; i < len; i++)
-      if (suffix[i] >= j) snd_key[p++] = suffix[i]-j;
-    
-    // Bucket sort based on fst_key and snd_key.
-    for (int i = 0; i < range; i++) bucket[i] = 0;
-    for (int i = 0; i < len; i++) ++bucket[fst_key[snd_key[i]]];
-    for (int i = 1; i < range; i++) bucket[i] += bucket[i-1];
-    for (int i = len-1; i >= 0; i--) suffix[--bucket[fst_key[snd_key[i]]]] = snd_key[i];
-
-    // Iterate: generate new fst_key
-    swap(&fst_key, &snd_key);
-    fst_key[suffix[0]] = 0; 
-    p = 1;
-    for (int i = 1; i < len; i++)
-      if (snd_key[suffix[i]] == snd_key[suffix[i-1]] &&
-          snd_key[suffix[i]+j] == snd_key[suffix[i-1]+j])
-        fst_key[suffix[i]] = p-1;
-      else fst_key[suffix[i]] = p++;
-
-    // The range of serials has updated
-    range = p;
-  }
- 
-  // Build rank[] and height[]
-  for (int i = 1; i < len; i++) rank[suffix[i]] = i;
-  p = 0;
-  for (int i = 0; i < len-1; height[rank[i++]] = p) {
-    if (p) --p;
-    for (int j = suffix[rank[i]-1]; str[i+p] == str[j+p]; p++) ;
-  }
+  sa_reserve(&sa, len);
+  sa_build(&sa, str, len, range);
+  suffix = sa.suffix;
+  height = sa.height;
 }
 
 /*
  * Monotonic stack API
  */
 
-struct {
+struct layer {
   // How many layers in stack have been
   // merged into this layer.
   int cnt; 
   // The minimum height of merged layers,
   // which is the length of this substring.
   int height;
-} mono_stack[ARR_SIZE];
+};
+
+// Layers start at 1, so it holds `capacity`+1 of them,
+// which grow with the input along with `str`.
+struct layer* mono_stack;
 
 // The current size of stack.
 int stack_size;
@@ -150,9 +87,29 @@ int stack_size;
 // need to maintain an belongingness array. Keep A's
 // length is enough to judge the belongingness.
 int len_of_A;
-// Inputs
-int str_len;
-char str[ARR_SIZE];
+// Inputs, concatenated into `str` which holds `capacity`
+// chars and grows with the input.
+int str_len, capacity;
+char* str;
+
+// Make room for `len` chars in str[], and as many layers
+// in mono_stack[].
+void reserve(int len) {
+  if (len <= capacity) return;
+  capacity = len > 2*capacity ? len : 2*capacity;
+  str = realloc(str, capacity);
+  mono_stack = realloc(mono_stack, sizeof(struct layer)*(capacity+1));
+}
+
+// Stream a string of the input into `str`.
+void read_input(void) {
+  char c;
+  io_skip_space();
+  while (read_token_char(&c)) {
+    reserve(str_len+1);
+    str[str_len++] = c;
+  }
+}
 
 // Solve the problem.
 long long solve(int len) {
@@ -274,28 +231,29 @@ long long solve(int len) {
 int main() {
 
   int K;
-  char tmp_str[ARR_SIZE/2];
   str_len = 1;
 
-  while (scanf("%d", &K) && K != 0) {
+  // str[0] is a dummy head, so that A starts at 1. It must differ
+  // from the 0 at the end, which has to be unique for SA-IS, and
+  // be smaller than '@' to keep the order of suffixes.
+  reserve(1);
+  str[0] = 1;
+
+  while (read_int(&K) && K != 0) {
 
     // Get inputted strings and concatenate them.
     // This step resembles POJ 3294.
-    scanf("%s", tmp_str);
-    for (int j = 0; tmp_str[j] != 0; j++) {
-      str[str_len++] = tmp_str[j];
-    }
+    read_input();
 
     // Record the length of string A.
     len_of_A = str_len - 1;
     // The concatenation character.
+    reserve(str_len+1);
     str[str_len++] = '@';
 
     // Get string B.
-    scanf("%s", tmp_str);
-    for (int j = 0; tmp_str[j] != 0; j++) {
-      str[str_len++] = tmp_str[j];
-    }
+    read_input();
+    reserve(str_len+1);
     str[str_len++] = 0;
 
     // Set suffix[], rank[] and height[].
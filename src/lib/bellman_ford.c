@@ -0,0 +1,173 @@
+/*
+ * Bellman-Ford APIs
+ * 
+ * SPFA-like FIFO Bellman-Ford with Tarjan's subtree disassembly
+ * (Tarjan, 1981; see also Cherkassky & Goldberg, 1999).
+ * 
+ * The parent pointers of the last improvements form a shortest
+ * path tree, whose edges are all tight: distance[c] is exactly
+ * distance[p] + weight(p, c). When distance[v] improves, all
+ * distances under `v` are stale, so the whole subtree of `v` is
+ * taken out of the tree before `v` is hung under its new parent:
+ * 
+ * - If the new parent `u` is in that subtree, the tree path from
+ *   `v` to `u` plus edge (u, v) is a cycle. The tree path weighs
+ *   distance[u] - distance[v], and the edge is shorter than
+ *   distance[v] - distance[u], so the cycle is negative. It's
+ *   found as soon as it appears in the parent pointers, instead
+ *   of after n updates of a vertex like a counter would.
+ * - Vertices taken out are skipped when they're popped, since
+ *   scanning `v` again would improve them anyway. That saves a
+ *   lot of useless scans even without any negative cycle.
+ * 
+ * The tree is kept as a doubly linked list in preorder, with the
+ * depth of each vertex, so the subtree of `v` is the run of
+ * vertices deeper than `v` right after it. Each vertex taken out
+ * was put into the tree by an improvement, so it costs O(1)
+ * amortized per improvement.
+ * 
+ */
+
+#include <string.h>
+#include "bellman_ford.h"
+
+// The list head, one past the last vertex.
+#define SENTINEL(bf) ((bf)->n+1)
+
+// depth[] of vertices out of the tree.
+#define OUT -1
+
+void bf_init(struct bellman_ford* bf, int n, const int* offsets, const int* targets,
+             const int* weights, int* distance, int* work) {
+  bf->n = n;
+  bf->offsets = offsets;
+  bf->targets = targets;
+  bf->weights = weights;
+  bf->distance = distance;
+  bf->parent = work;
+  bf->queue = work + (n+2);
+  bf->queued = work + 2*(n+2);
+  bf->depth = work + 3*(n+2);
+  bf->next = work + 4*(n+2);
+  bf->prev = work + 5*(n+2);
+}
+
+void bf_clear(struct bellman_ford* bf) {
+  int n = bf->n;
+  for (int i = 0; i <= n; i++) {
+    bf->distance[i] = BF_INF;
+    bf->parent[i] = -1;
+    bf->depth[i] = OUT;
+  }
+  memset(bf->queued, 0, sizeof(int)*(n+1));
+
+  // An empty list, whose head is deeper than no vertex.
+  bf->next[SENTINEL(bf)] = bf->prev[SENTINEL(bf)] = SENTINEL(bf);
+  bf->depth[SENTINEL(bf)] = OUT;
+
+  bf->q_head = bf->q_tail = 0;
+  bf->cycle_from = bf->cycle_to = -1;
+}
+
+// Queue `v` if it's not queued. Each vertex is queued at most
+// once, so n+2 slots are enough for a circular queue.
+static void push(struct bellman_ford* bf, int v) {
+  if (!bf->queued[v]) {
+    bf->queued[v] = 1;
+    bf->queue[bf->q_head] = v;
+    bf->q_head = bf->q_head == bf->n+1 ? 0 : bf->q_head+1;
+  }
+}
+
+// Insert `v` into the list right after `pos`.
+static void link_after(struct bellman_ford* bf, int pos, int v) {
+  bf->next[v] = bf->next[pos];
+  bf->prev[v] = pos;
+  bf->prev[bf->next[pos]] = v;
+  bf->next[pos] = v;
+}
+
+void bf_root(struct bellman_ford* bf, int v, int d, int push_it) {
+  bf->distance[v] = d;
+  bf->parent[v] = -1;
+  bf->depth[v] = 0;
+  link_after(bf, SENTINEL(bf), v);
+  if (push_it) push(bf, v);
+}
+
+// Take `v` and its subtree out of the tree. Return 0 if `u`
+// is in the subtree, which closes a negative cycle.
+static int disassemble(struct bellman_ford* bf, int v, int u) {
+  int* depth = bf->depth;
+  int* next = bf->next;
+
+  if (v == u) return 0;
+  if (depth[v] == OUT) return 1;
+
+  int end = next[v];
+  while (depth[end] > depth[v]) {
+    if (end == u) return 0;
+    depth[end] = OUT;
+    end = next[end];
+  }
+
+  // Unlink the whole run [v, end) at once.
+  next[bf->prev[v]] = end;
+  bf->prev[end] = bf->prev[v];
+  depth[v] = OUT;
+  return 1;
+}
+
+int bf_run(struct bellman_ford* bf) {
+  const int* offsets = bf->offsets;
+  const int* targets = bf->targets;
+  const int* weights = bf->weights;
+  int* distance = bf->distance;
+
+  while (bf->q_head != bf->q_tail) {
+
+    // Pick a vertex out of queue
+    int from = bf->queue[bf->q_tail];
+    bf->q_tail = bf->q_tail == bf->n+1 ? 0 : bf->q_tail+1;
+    bf->queued[from] = 0;
+
+    // Its distance is stale if it's been taken out.
+    if (bf->depth[from] == OUT) continue;
+
+    for (int i = offsets[from]; i < offsets[from+1]; i++) {
+      int to = targets[i];
+      int d = distance[from] + weights[i];
+      if (d < distance[to]) {
+        if (!disassemble(bf, to, from)) {
+          bf->cycle_from = from;
+          bf->cycle_to = to;
+          return 0;
+        }
+
+        // Hang `to` under `from`.
+        distance[to] = d;
+        bf->parent[to] = from;
+        bf->depth[to] = bf->depth[from] + 1;
+        link_after(bf, from, to);
+        push(bf, to);
+      }
+    }
+  }
+
+  return 1;
+}
+
+int bf_cycle(const struct bellman_ford* bf, int* cycle) {
+
+  // Walk up the tree from `cycle_from` to `cycle_to`, which
+  // gives the cycle backwards.
+  int len = 0;
+  for (int v = bf->cycle_from; v != bf->cycle_to; v = bf->parent[v])
+    cycle[len++] = v;
+  cycle[len++] = bf->cycle_to;
+
+  for (int i = 0, j = len-1; i < j; i++, j--) {
+    int t = cycle[i]; cycle[i] = cycle[j]; cycle[j] = t;
+  }
+  return len;
+}
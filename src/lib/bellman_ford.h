@@ -0,0 +1,74 @@
+/*
+ * Bellman-Ford APIs
+ * 
+ * Single-source shortest paths on a CSR graph over vertices
+ * [0, n] with any integer weights, which stops early once it
+ * finds a negative cycle and could tell which cycle it is.
+ * 
+ * Longest paths (difference constraints like `b - a >= c`) are
+ * shortest paths with all weights negated, so a positive cycle
+ * there is a negative one here.
+ * 
+ * All buffers are owned by the caller: distance[] takes n+1 ints,
+ * and `work` takes BF_WORK_SIZE(n) ints.
+ * 
+ */
+
+#ifndef BELLMAN_FORD_H
+#define BELLMAN_FORD_H
+
+// distance[] of vertices not reached yet.
+#define BF_INF 0x3f3f3f3f
+
+// The number of ints `work` needs for vertices [0, n].
+#define BF_WORK_SIZE(n) (6*((n)+2))
+
+struct bellman_ford {
+  int n; // vertices are in range [0, n]
+  const int* offsets; // out-edges of `i` are [offsets[i], offsets[i+1])
+  const int* targets;
+  const int* weights;
+  int* distance; // n+1 ints
+  int* parent; // parent[i] in the shortest path tree, -1 for roots
+
+  // Internals, all carved out of `work`
+  int* queue;
+  int* queued;
+  int* depth;
+  int* next;
+  int* prev;
+  int q_head;
+  int q_tail;
+
+  // The edge closing the negative cycle, from `cycle_from`
+  // to `cycle_to`, -1 if none has been found.
+  int cycle_from;
+  int cycle_to;
+};
+
+// Point `bf` at a CSR graph over [0, n] and caller-owned buffers.
+// Weights could be patched in place between runs.
+void bf_init(struct bellman_ford* bf, int n, const int* offsets, const int* targets,
+             const int* weights, int* distance, int* work);
+
+// Make all vertices unreached.
+void bf_clear(struct bellman_ford* bf);
+
+// Make an unreached `v` a root at distance `d`, and queue it if
+// `push`. Several roots could be set to warm-start from earlier
+// distances: it's correct as long as each of them is an upper
+// bound on the shortest distance from the source (e.g. the length
+// of some path), and all vertices that could have an edge out of
+// them relaxed are queued.
+void bf_root(struct bellman_ford* bf, int v, int d, int push);
+
+// Relax edges until no distance could be improved. Return 1 if
+// so, or 0 once a negative cycle is found. The state is broken
+// afterwards until the next bf_clear().
+int bf_run(struct bellman_ford* bf);
+
+// After bf_run() returned 0, store the negative cycle into `cycle`
+// (up to n+1 ints) in the order of its edges, return its length.
+int bf_cycle(const struct bellman_ford* bf, int* cycle);
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * Compressed sparse row (CSR) APIs
+ *
+ * Walking a linked list of edges jumps around the edge array, which
+ * costs a cache miss per edge. So once all edges are added, solvers
+ * freeze the graph into CSR: edges are counting-sorted by their
+ * source, so all out-edges of `i` are targets[offsets[i]..offsets[i+1])
+ * and weights[...] in the same range, and could be streamed in order.
+ *
+ * Each solver keeps edges in its own array of structs, so the freeze
+ * is generated per solver by DEFINE_CSR_FREEZE(), which reads their
+ * fields by name:
+ *
+ * - edges: the array of edges
+ * - from: the field of an edge that holds its source
+ * - offsets: the int array of n+2 offsets to build
+ * - PUT(pos, edge): stores `edge` into slot `pos` of the solver's
+ *   targets[] (and weights[], if any)
+ *
+ * The defined `void name(int n, int m)` freezes edges[0..m) of
+ * vertices [0, n]. It keeps the input order within each source.
+ *
+ */
+
+#ifndef CSR_H
+#define CSR_H
+
+#include <string.h>
+
+#define DEFINE_CSR_FREEZE(name, edges, from, offsets, PUT)                \
+void name(int n, int m) {                                                 \
+                                                                          \
+  /* Count out-edges of each vertex */                                    \
+  memset(offsets, 0, sizeof(int)*(n+2));                                  \
+  for (int i = 0; i < m; i++) offsets[(edges)[i].from+1]++;               \
+  for (int i = 1; i <= n+1; i++) offsets[i] += offsets[i-1];              \
+                                                                          \
+  /* Put each edge into the slot of its source. offsets[from] */          \
+  /* is used as the cursor and shifted back afterwards. */                \
+  for (int i = 0; i < m; i++) {                                           \
+    int pos = offsets[(edges)[i].from]++;                                 \
+    PUT(pos, (edges)[i]);                                                 \
+  }                                                                       \
+  for (int i = n; i > 0; i--) offsets[i] = offsets[i-1];                  \
+  offsets[0] = 0;                                                         \
+}
+
+#endif
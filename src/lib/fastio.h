@@ -0,0 +1,229 @@
+/*
+ * Fast input/output APIs
+ * 
+ * scanf() parses its format string and takes the locale lock for
+ * every call, which turns into most of the running time once the
+ * input has 100k+ lines. These functions parse integers, chars and
+ * tokens from stdin by hand instead.
+ * 
+ * If stdin is a regular file, it is mapped into memory at once;
+ * elsewise (pipes, terminals) it is read in large blocks. Either
+ * way, the parser sees the input as a window [io_ptr, io_end).
+ * 
+ * Like scanf(), all readers skip leading whitespace, and return 0
+ * (leaving the output untouched) at the end of input, so loops like
+ * `while (scanf("%d", &n) == 1)` become `while (read_int(&n))`.
+ * 
+ * Do not mix them with scanf() on stdin, as the block reader
+ * may have consumed input that scanf() would expect.
+ * 
+ */
+
+#ifndef FASTIO_H
+#define FASTIO_H
+
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define IO_BUF_SIZE (1<<16)
+
+static char io_buf[IO_BUF_SIZE];
+
+// The unread part of input.
+static const char* io_ptr;
+static const char* io_end;
+
+// 1 if stdin has been mapped, so there is nothing to refill.
+static int io_mapped;
+// 1 after the first refill, when we decide how to read stdin.
+static int io_ready;
+
+// Make the window non-empty, return 0 at the end of input.
+static int io_refill(void) {
+
+  // At the first time, try to map stdin if it's a regular file.
+  if (!io_ready) {
+    struct stat st;
+    io_ready = 1;
+    if (fstat(0, &st) == 0 && S_ISREG(st.st_mode)) {
+      off_t pos = lseek(0, 0, SEEK_CUR);
+      if (pos >= 0 && st.st_size > pos) {
+        void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, 0, 0);
+        if (addr != MAP_FAILED) {
+          madvise(addr, st.st_size, MADV_SEQUENTIAL);
+          io_ptr = (const char*)addr + pos;
+          io_end = (const char*)addr + st.st_size;
+          io_mapped = 1;
+          return 1;
+        }
+      }
+    }
+  }
+
+  if (io_mapped) return 0;
+
+  ssize_t n = read(0, io_buf, IO_BUF_SIZE);
+  if (n <= 0) return 0;
+  io_ptr = io_buf;
+  io_end = io_buf + n;
+  return 1;
+}
+
+// Return the next char without consuming it, or EOF.
+static inline int io_peek(void) {
+  if (io_ptr == io_end && !io_refill()) return EOF;
+  return (unsigned char)*io_ptr;
+}
+
+// Return the char after the next one without consuming either,
+// or EOF. If the block ends between them, the next char is moved
+// to the front of the buffer before the refill, so it's kept.
+static inline int io_peek_next(void) {
+  if (io_peek() == EOF) return EOF;
+  if (io_end - io_ptr < 2 && !io_mapped) {
+    char c = *io_ptr;
+    ssize_t n = read(0, io_buf+1, IO_BUF_SIZE-1);
+    io_buf[0] = c;
+    io_ptr = io_buf;
+    io_end = io_buf + 1 + (n > 0 ? n : 0);
+  }
+  return io_end - io_ptr < 2 ? EOF : (unsigned char)io_ptr[1];
+}
+
+// Skip whitespace, return the next char or EOF.
+static inline int io_skip_space(void) {
+  int c;
+  while ((c = io_peek()) != EOF && c <= ' ') io_ptr++;
+  return c;
+}
+
+// Read a (possibly negative) decimal integer. Nothing is consumed
+// but whitespace if there's no integer, even after a '-'.
+static inline int read_long(long long* x) {
+  int c = io_skip_space(), neg = 0;
+  if (c == '-') {
+    c = io_peek_next();
+    if (c < '0' || c > '9') return 0;
+    neg = 1;
+    io_ptr++;
+  }
+  if (c < '0' || c > '9') return 0;
+
+  unsigned long long v = 0;
+  while ((c = io_peek()) >= '0' && c <= '9') {
+    v = v*10 + (c-'0');
+    io_ptr++;
+  }
+
+  *x = neg ? -(long long)v : (long long)v;
+  return 1;
+}
+
+static inline int read_int(int* x) {
+  long long v;
+  if (!read_long(&v)) return 0;
+  *x = (int)v;
+  return 1;
+}
+
+// Read a non-whitespace char, like scanf(" %c").
+static inline int read_char(char* x) {
+  int c = io_skip_space();
+  if (c == EOF) return 0;
+  *x = (char)c;
+  io_ptr++;
+  return 1;
+}
+
+// Read a whitespace-delimited token into `s`, like scanf("%s").
+// Return the length of the token.
+static inline int read_str(char* s) {
+  int c = io_skip_space(), len = 0;
+  while (c != EOF && c > ' ') {
+    s[len++] = (char)c;
+    io_ptr++;
+    c = io_peek();
+  }
+  s[len] = 0;
+  return len;
+}
+
+// Read the next char of the current token, or return 0 at
+// whitespace or the end of input. Call io_skip_space() to get
+// to a token first. Tokens of any length could be read this
+// way, without a buffer to hold them.
+static inline int read_token_char(char* x) {
+  int c = io_peek();
+  if (c == EOF || c <= ' ') return 0;
+  *x = (char)c;
+  io_ptr++;
+  return 1;
+}
+
+// Skip whitespace and consume the literal char `x` if it's
+// the next one, like the ":(" in scanf("%d:(%d)").
+// Return 1 if `x` is consumed.
+static inline int skip_char(char x) {
+  if (io_skip_space() != (unsigned char)x) return 0;
+  io_ptr++;
+  return 1;
+}
+
+/*
+ * Output APIs
+ * 
+ * Answers are formatted by hand into a buffer, which is written
+ * to stdout in large chunks. Solvers that use them should call
+ * flush_output() before exit, and should not print to stdout
+ * with printf() in the meantime, or the output would be reordered.
+ */
+
+static char out_buf[IO_BUF_SIZE];
+static int out_len;
+
+// Write the whole buffer to stdout.
+static inline void flush_output(void) {
+  int done = 0;
+  while (done < out_len) {
+    ssize_t n = write(1, out_buf + done, out_len - done);
+    if (n <= 0) break;
+    done += n;
+  }
+  out_len = 0;
+}
+
+// Ensure there are at least `n` free bytes in the buffer.
+static inline void out_reserve(int n) {
+  if (out_len + n > IO_BUF_SIZE) flush_output();
+}
+
+static inline void write_char(char c) {
+  out_reserve(1);
+  out_buf[out_len++] = c;
+}
+
+static inline void write_long(long long x) {
+
+  // 20 digits and a sign at most.
+  char tmp[24];
+  int len = 0;
+  unsigned long long v = x < 0 ? -(unsigned long long)x : (unsigned long long)x;
+
+  out_reserve(24);
+  if (x < 0) out_buf[out_len++] = '-';
+
+  // Digits come out in reverse order.
+  do {
+    tmp[len++] = '0' + v % 10;
+    v /= 10;
+  } while (v);
+  while (len) out_buf[out_len++] = tmp[--len];
+}
+
+static inline void write_int(int x) {
+  write_long(x);
+}
+
+#endif
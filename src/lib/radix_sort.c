@@ -0,0 +1,61 @@
+/*
+ * Radix sort APIs
+ * 
+ * One pass counts all digits of all keys. Each digit is then
+ * scattered by its own pass, from the lowest to the highest. A
+ * digit that all keys share, like the high bytes of small keys,
+ * would not move anything, so its pass is skipped.
+ * 
+ * The counts (up to 8 KiB) live on the stack, so sorts could run
+ * in several threads at once.
+ * 
+ */
+
+#include <string.h>
+#include "radix_sort.h"
+
+#define RADIX_BITS 8
+#define RADIX (1 << RADIX_BITS)
+
+// Define a sort `name` over an array of `type`, where `KEY(x)`
+// is the key of `x`, of `bytes` bytes.
+#define DEFINE_RADIX_SORT(name, type, bytes, KEY)                         \
+void name(type* data, type* tmp, int n) {                                 \
+  int count[bytes][RADIX];                                                \
+  if (n < 2) return;                                                      \
+                                                                          \
+  memset(count, 0, sizeof(count));                                        \
+  for (int i = 0; i < n; i++) {                                           \
+    unsigned long long key = KEY(data[i]);                                \
+    for (int d = 0; d < bytes; d++)                                       \
+      count[d][(key >> (d*RADIX_BITS)) & (RADIX-1)]++;                    \
+  }                                                                       \
+                                                                          \
+  type* from = data;                                                      \
+  type* to = tmp;                                                         \
+  for (int d = 0; d < bytes; d++) {                                       \
+    int shift = d*RADIX_BITS;                                             \
+    if (count[d][(KEY(from[0]) >> shift) & (RADIX-1)] == n) continue;    \
+                                                                          \
+    int start = 0;                                                        \
+    for (int b = 0; b < RADIX; b++) {                                     \
+      int cnt = count[d][b];                                              \
+      count[d][b] = start;                                                \
+      start += cnt;                                                       \
+    }                                                                     \
+    for (int i = 0; i < n; i++)                                           \
+      to[count[d][(KEY(from[i]) >> shift) & (RADIX-1)]++] = from[i];      \
+                                                                          \
+    type* t = from; from = to; to = t;                                    \
+  }                                                                       \
+                                                                          \
+  if (from != data) memcpy(data, from, sizeof(type) * n);                 \
+}
+
+#define KEY_SELF(x) (x)
+#define KEY_FIELD(x) ((x).key)
+
+DEFINE_RADIX_SORT(radix_sort_u32, unsigned, 4, KEY_SELF)
+DEFINE_RADIX_SORT(radix_sort_u64, unsigned long long, 8, KEY_SELF)
+DEFINE_RADIX_SORT(radix_sort_pairs32, struct radix_pair32, 4, KEY_FIELD)
+DEFINE_RADIX_SORT(radix_sort_pairs64, struct radix_pair64, 8, KEY_FIELD)
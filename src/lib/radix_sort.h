@@ -0,0 +1,37 @@
+/*
+ * Radix sort APIs
+ * 
+ * LSD radix sort over 8-bit digits, for unsigned 32-bit and 64-bit
+ * keys, and for records of a key and a payload. All sorts are
+ * stable and run in O(n) passes without comparisons.
+ * 
+ * Signed keys that are never negative sort the same as unsigned.
+ * 
+ * Each sort needs a caller-owned `tmp` buffer as large as the input.
+ * The result is always left in the input buffer.
+ * 
+ */
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+// A 32-bit key with a payload.
+struct radix_pair32 {
+  unsigned key;
+  int value;
+};
+
+// A 64-bit key with a payload.
+struct radix_pair64 {
+  unsigned long long key;
+  long long value;
+};
+
+void radix_sort_u32(unsigned* keys, unsigned* tmp, int n);
+void radix_sort_u64(unsigned long long* keys, unsigned long long* tmp, int n);
+
+// Sort records by key, payloads follow their keys.
+void radix_sort_pairs32(struct radix_pair32* pairs, struct radix_pair32* tmp, int n);
+void radix_sort_pairs64(struct radix_pair64* pairs, struct radix_pair64* tmp, int n);
+
+#endif
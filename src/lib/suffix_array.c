@@ -0,0 +1,453 @@
+/*
+ * Suffix array APIs
+ * 
+ * The doubling builder is the one POJ 3294 and POJ 3415 used
+ * to carry. It does O(logN) rounds of bucket sort, and each of
+ * them visits the whole string in random order, so it's slow
+ * when N grows large or the string is periodic.
+ * 
+ * SA-IS (Nong, Zhang & Chan, 2009) sorts all suffixes in linear
+ * time. Each suffix is typed S if it's smaller than the suffix
+ * right after it, L otherwise; an S-suffix right after an
+ * L-suffix is a LMS (leftmost S) suffix. Once all LMS suffixes
+ * are sorted, two sequential passes over the buckets (induce())
+ * sort all L-suffixes and then all S-suffixes. To sort the LMS
+ * suffixes, we sort LMS substrings by induction first, name
+ * them, and solve the reduced string (at most half as long)
+ * recursively.
+ * 
+ * height[] is derived from suffix[] by Kasai's algorithm, and the
+ * sparse table stores min(height[i..i+2^k)) at level `k`. Kasai
+ * prefetches what it reads a few steps ahead, and extends long
+ * common prefixes by 16 or 32 bytes per compare where SSE2 or
+ * AVX2 is available, or one char at a time if not (or with
+ * -DSA_NO_SIMD).
+ * 
+ * Strings of chars and of ints share the same code: SA-IS works
+ * on ints anyway, and Kasai is defined for both by a macro.
+ * 
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "suffix_array.h"
+
+#ifndef SA_NO_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SA_VECTOR 32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SA_VECTOR 16
+#endif
+#endif
+
+// Chars compared one by one before vectors.
+#ifndef SA_SHORT_LCP
+#define SA_SHORT_LCP 8
+#endif
+
+// How many steps ahead Kasai fetches suffix[] and height[] for,
+// 0 to turn it off. The string is fetched half as far, once
+// suffix[] is in cache.
+#ifndef SA_PREFETCH
+#define SA_PREFETCH 32
+#endif
+
+/*
+ * SA-IS
+ */
+
+// Suffix types
+#define L_TYPE 0
+#define S_TYPE 1
+
+// Whether suffix `i` is a LMS suffix.
+#define IS_LMS(type, i) ((i) > 0 && (type)[i] == S_TYPE && (type)[(i)-1] == L_TYPE)
+
+// Set bucket[c] to the head (or the end, if `end`) of the bucket
+// of char `c` in the suffix array.
+static void get_buckets(const int* s, int n, int range, int* bucket, int end) {
+  memset(bucket, 0, sizeof(int)*range);
+  for (int i = 0; i < n; i++) bucket[s[i]]++;
+
+  int sum = 0;
+  for (int c = 0; c < range; c++) {
+    sum += bucket[c];
+    bucket[c] = end ? sum : sum - bucket[c];
+  }
+}
+
+// Induce the order of L-suffixes from the LMS suffixes placed at
+// the ends of their buckets, then the order of S-suffixes from
+// the L-suffixes.
+static void induce(const int* s, int* sa, const char* type, int n, int range, int* bucket) {
+
+  // L-suffixes: scan from left to right, put suffix j-1 at the
+  // head of its bucket if it's L-type.
+  get_buckets(s, n, range, bucket, 0);
+  for (int i = 0; i < n; i++) {
+    int j = sa[i] - 1;
+    if (j >= 0 && type[j] == L_TYPE) sa[bucket[s[j]]++] = j;
+  }
+
+  // S-suffixes: scan from right to left, put them at the ends.
+  get_buckets(s, n, range, bucket, 1);
+  for (int i = n-1; i >= 0; i--) {
+    int j = sa[i] - 1;
+    if (j >= 0 && type[j] == S_TYPE) sa[--bucket[s[j]]] = j;
+  }
+}
+
+// Build the suffix array of s[0..n), where s[n-1] is the unique
+// minimum, and all values are in [0, range).
+static void sais(const int* s, int* sa, int n, int range) {
+
+  if (n == 1) {
+    sa[0] = 0;
+    return;
+  }
+
+  char* type = malloc(n);
+  int* bucket = malloc(sizeof(int)*range);
+
+  // Classify all suffixes from right to left.
+  type[n-1] = S_TYPE;
+  type[n-2] = L_TYPE;
+  for (int i = n-3; i >= 0; i--)
+    type[i] = (s[i] < s[i+1] || (s[i] == s[i+1] && type[i+1] == S_TYPE)) ? S_TYPE : L_TYPE;
+
+  // Stage 1: sort LMS substrings.
+  //
+  // Put LMS suffixes at the ends of their buckets in any order,
+  // and induce. LMS substrings come out sorted, though LMS
+  // suffixes may not be.
+  get_buckets(s, n, range, bucket, 1);
+  for (int i = 0; i < n; i++) sa[i] = -1;
+  for (int i = 1; i < n; i++)
+    if (IS_LMS(type, i)) sa[--bucket[s[i]]] = i;
+  induce(s, sa, type, n, range, bucket);
+
+  // Move the sorted LMS substrings to the front of sa[].
+  int n1 = 0;
+  for (int i = 0; i < n; i++)
+    if (IS_LMS(type, sa[i])) sa[n1++] = sa[i];
+
+  // Name the LMS substrings: equal substrings get equal names.
+  // LMS positions are at least 2 apart, so sa[n1 + pos/2] is
+  // a free slot for each of them.
+  for (int i = n1; i < n; i++) sa[i] = -1;
+  int name = 0, prev = -1;
+  for (int i = 0; i < n1; i++) {
+    int pos = sa[i], diff = 0;
+    for (int d = 0; ; d++) {
+      if (prev == -1 || s[pos+d] != s[prev+d] || type[pos+d] != type[prev+d]) {
+        diff = 1;
+        break;
+      } else if (d > 0 && (IS_LMS(type, pos+d) || IS_LMS(type, prev+d))) {
+        break;
+      }
+    }
+    if (diff) {
+      name++;
+      prev = pos;
+    }
+    sa[n1 + pos/2] = name - 1;
+  }
+
+  // Gather the names, in the order of positions, at the end of sa[].
+  for (int i = n-1, j = n-1; i >= n1; i--)
+    if (sa[i] >= 0) sa[j--] = sa[i];
+
+  // Stage 2: sort LMS suffixes by solving the reduced string s1,
+  // recursively if some names are shared.
+  int* s1 = sa + n - n1;
+  int* sa1 = sa;
+  if (name < n1) sais(s1, sa1, n1, name);
+  else for (int i = 0; i < n1; i++) sa1[s1[i]] = i;
+
+  // Stage 3: induce the whole suffix array from sorted LMS suffixes.
+  //
+  // s1 is no longer needed, reuse it to map indexes in the reduced
+  // string back to positions in s.
+  for (int i = 1, j = 0; i < n; i++)
+    if (IS_LMS(type, i)) s1[j++] = i;
+  for (int i = 0; i < n1; i++) sa1[i] = s1[sa1[i]];
+  for (int i = n1; i < n; i++) sa[i] = -1;
+
+  get_buckets(s, n, range, bucket, 1);
+  for (int i = n1-1; i >= 0; i--) {
+    int j = sa[i];
+    sa[i] = -1;
+    sa[--bucket[s[j]]] = j;
+  }
+  induce(s, sa, type, n, range, bucket);
+
+  free(type);
+  free(bucket);
+}
+
+void sa_build_sais(const char* str, int len, int range, int* suffix) {
+
+  // The recursion works on int strings.
+  int* s = malloc(sizeof(int)*len);
+  for (int i = 0; i < len; i++) s[i] = (unsigned char)str[i];
+
+  sais(s, suffix, len, range);
+  free(s);
+}
+
+void sa_build_sais_int(const int* str, int len, int range, int* suffix) {
+  sais(str, suffix, len, range);
+}
+
+/*
+ * Prefix doubling
+ */
+
+// A simple swap function
+static void swap(int** x, int** y) {
+  int *tmp = *x;
+  *x = *y;
+  *y = tmp;
+}
+
+void sa_build_doubling(const char* str, int len, int range, int* suffix) {
+
+  // We use two keys iteratively in doubling process.
+  int* fst_key = malloc(sizeof(int)*len);
+  int* snd_key = malloc(sizeof(int)*len);
+  // Use bucket sort to reduce time complexity.
+  int* bucket = malloc(sizeof(int)*(len > range ? len : range));
+
+  // Init the bucket
+  for (int i = 0; i < range; i++) bucket[i] = 0;
+
+  // Set the first key
+  for (int i = 0; i < len; i++) {
+    fst_key[i] = (unsigned char)str[i];
+    ++bucket[fst_key[i]];
+  }
+
+  // Bucket sort on suffix[] based on the first key
+  for (int i = 1; i < range; i++) bucket[i] += bucket[i-1];
+  for (int i = len-1; i >= 0; i--) suffix[--bucket[fst_key[i]]] = i;
+
+  // Use a temporary value `p` to store the next
+  // serial to be assigned.
+  int p = 1;
+
+  // Doubling period.
+  // `j` is the doubling step.
+  for (int j = 1; p < len; j *= 2) {
+    p = 0;
+
+    // Handle the gap between n*j and len.
+    // This part of value do not have the second key.
+    for (int i = len-j; i < len; i++) snd_key[p++] = i;
+
+    // Calculate all `snd_key`s.
+    for (int i = 0; i < len; i++)
+      if (suffix[i] >= j) snd_key[p++] = suffix[i]-j;
+
+    // Bucket sort based on fst_key and snd_key.
+    for (int i = 0; i < range; i++) bucket[i] = 0;
+    for (int i = 0; i < len; i++) ++bucket[fst_key[snd_key[i]]];
+    for (int i = 1; i < range; i++) bucket[i] += bucket[i-1];
+    for (int i = len-1; i >= 0; i--) suffix[--bucket[fst_key[snd_key[i]]]] = snd_key[i];
+
+    // Iterate: generate new fst_key
+    //
+    // Since the sentinel is unique, two suffixes with equal
+    // first keys never reach the end of string, so
+    // `suffix[i]+j` is always in range when it's read.
+    swap(&fst_key, &snd_key);
+    fst_key[suffix[0]] = 0;
+    p = 1;
+    for (int i = 1; i < len; i++)
+      if (snd_key[suffix[i]] == snd_key[suffix[i-1]] &&
+          snd_key[suffix[i]+j] == snd_key[suffix[i-1]+j])
+        fst_key[suffix[i]] = p-1;
+      else fst_key[suffix[i]] = p++;
+
+    // The range of serials has updated
+    range = p;
+  }
+
+  free(fst_key);
+  free(snd_key);
+  free(bucket);
+}
+
+/*
+ * Suffix array with rank[], height[] and RMQ
+ */
+
+#ifdef SA_VECTOR
+
+// A mask of the bytes that differ between the
+// SA_VECTOR bytes at `a` and the ones at `b`.
+static inline unsigned vector_diff(const void* a, const void* b) {
+#if SA_VECTOR == 32
+  __m256i x = _mm256_loadu_si256((const __m256i*)a);
+  __m256i y = _mm256_loadu_si256((const __m256i*)b);
+  return ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+#else
+  __m128i x = _mm_loadu_si128((const __m128i*)a);
+  __m128i y = _mm_loadu_si128((const __m128i*)b);
+  return ~_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xffff;
+#endif
+}
+
+#else
+
+// No vectors, extensions go one char at a time.
+#define SA_VECTOR 0
+static inline unsigned vector_diff(const void* a, const void* b) {
+  return 0;
+}
+
+#endif
+
+// Define `name`, which extends the common prefix `p` of suffixes
+// `i` and `j` of a string of `type` with length `len` until they
+// differ, and returns the new length. The unique trailing 0 makes
+// them differ before the end.
+//
+// Most extensions are short, so a few chars are tried alone before
+// loading vectors that may straddle two cache lines. Vectors are
+// compared while both loads stay in the string, and the first
+// mismatch is the lowest byte set in the mask of differing ones.
+#define DEFINE_EXTEND_LCP(name, type)                                     \
+static int name(const type* str, int len, int i, int j, int p) {          \
+  if (SA_VECTOR) {                                                        \
+    for (int end = p + SA_SHORT_LCP; p < end; p++)                        \
+      if (str[i+p] != str[j+p]) return p;                                 \
+                                                                          \
+    int step = SA_VECTOR / (int)sizeof(type);                             \
+    int limit = len - step - (i > j ? i : j);                             \
+    for (; p <= limit; p += step) {                                       \
+      unsigned diff = vector_diff(str+i+p, str+j+p);                      \
+      if (diff) return p + __builtin_ctz(diff) / (int)sizeof(type);       \
+    }                                                                     \
+  }                                                                       \
+                                                                          \
+  while (str[i+p] == str[j+p]) p++;                                       \
+  return p;                                                               \
+}
+
+DEFINE_EXTEND_LCP(extend_lcp, char)
+DEFINE_EXTEND_LCP(extend_lcp_int, int)
+
+void sa_init(struct suffix_array* sa, int* suffix, int* rank, int* height, int capacity) {
+  sa->len = 0;
+  sa->capacity = capacity;
+  sa->suffix = suffix;
+  sa->rank = rank;
+  sa->height = height;
+  sa->table = NULL;
+  sa->levels = 0;
+}
+
+void sa_reserve(struct suffix_array* sa, int len) {
+  if (len <= sa->capacity) return;
+  int capacity = len > 2*sa->capacity ? len : 2*sa->capacity;
+  free(sa->suffix), free(sa->rank), free(sa->height);
+  sa_init(sa, malloc(sizeof(int)*capacity), malloc(sizeof(int)*capacity),
+    malloc(sizeof(int)*(capacity+1)), capacity);
+}
+
+void sa_build(struct suffix_array* sa, const char* str, int len, int range) {
+  sa->len = len;
+  sa->table = NULL;
+  sa_build_sais(str, len, range, sa->suffix);
+  sa_build_height(sa, str);
+}
+
+void sa_build_int(struct suffix_array* sa, const int* str, int len, int range) {
+  sa->len = len;
+  sa->table = NULL;
+  sa_build_sais_int(str, len, range, sa->suffix);
+  sa_build_height_int(sa, str);
+}
+
+// Define `name`, which builds rank[] and height[] of a string of
+// `type` from suffix[], with `extend` to extend common prefixes.
+//
+// Kasai: the LCP of suffix i+1 with its predecessor is at least
+// that of suffix i minus one, so `p` drops by at most one per
+// step and the loop is O(len) in total. The unique sentinel
+// stops the comparison before it runs out of the string.
+//
+// Each step reads suffix[] and the string, and writes height[],
+// at places all over the memory, and that's where the time goes
+// rather than in the comparison. But rank[] is read in order, so
+// these places are known a few steps ahead and could be fetched
+// in time.
+#define DEFINE_BUILD_HEIGHT(name, type, extend)                           \
+void name(struct suffix_array* sa, const type* str) {                     \
+  int len = sa->len;                                                      \
+  int* suffix = sa->suffix;                                               \
+  int* rank = sa->rank;                                                   \
+  int* height = sa->height;                                               \
+                                                                          \
+  for (int i = 0; i < len; i++) rank[suffix[i]] = i;                      \
+                                                                          \
+  int p = 0;                                                              \
+  height[0] = height[len] = 0;                                            \
+  for (int i = 0; i < len-1; height[rank[i++]] = p) {                     \
+    if (SA_PREFETCH && i + SA_PREFETCH < len-1) {                         \
+      __builtin_prefetch(&suffix[rank[i+SA_PREFETCH]-1]);                 \
+      __builtin_prefetch(&height[rank[i+SA_PREFETCH]], 1);                \
+    }                                                                     \
+    if (SA_PREFETCH && i + SA_PREFETCH/2 < len-1)                         \
+      __builtin_prefetch(str + suffix[rank[i+SA_PREFETCH/2]-1] + p);      \
+                                                                          \
+    if (p) --p;                                                           \
+    p = extend(str, len, i, suffix[rank[i]-1], p);                        \
+  }                                                                       \
+}
+
+DEFINE_BUILD_HEIGHT(sa_build_height, char, extend_lcp)
+DEFINE_BUILD_HEIGHT(sa_build_height_int, int, extend_lcp_int)
+
+int sa_rmq_size(int len) {
+  int levels = 1;
+  while ((1 << levels) <= len) levels++;
+  return levels * len;
+}
+
+void sa_build_rmq(struct suffix_array* sa, int* table) {
+  int len = sa->len;
+
+  sa->table = table;
+  sa->levels = sa_rmq_size(len) / len;
+  memcpy(table, sa->height, sizeof(int)*len);
+
+  // Level k is made of two overlapping blocks of level k-1.
+  for (int k = 1; k < sa->levels; k++) {
+    int* prev = table + (k-1)*len;
+    int* cur = table + k*len;
+    int half = 1 << (k-1);
+    for (int i = 0; i + 2*half <= len; i++)
+      cur[i] = prev[i] < prev[i+half] ? prev[i] : prev[i+half];
+  }
+}
+
+int sa_rmq(const struct suffix_array* sa, int l, int r) {
+  int k = 31 - __builtin_clz(r - l + 1);
+  const int* level = sa->table + k*sa->len;
+  int a = level[l], b = level[r - (1 << k) + 1];
+  return a < b ? a : b;
+}
+
+int sa_lcp(const struct suffix_array* sa, int i, int j) {
+  if (i == j) return sa->len - 1 - i;
+
+  int ri = sa->rank[i], rj = sa->rank[j];
+  if (ri > rj) {
+    int tmp = ri;
+    ri = rj, rj = tmp;
+  }
+  return sa_rmq(sa, ri+1, rj);
+}
@@ -0,0 +1,85 @@
+/*
+ * Suffix array APIs
+ * 
+ * A suffix array of a string `str` with length `len` has:
+ * 
+ * - suffix[i]: the start of the `i`th smallest suffix
+ * - rank[j]: the inverse of suffix[], suffix[rank[j]] = j
+ * - height[i]: length of the longest common prefix between
+ *   suffix[i] and suffix[i-1]; height[0] = 0, and height[len] = 0
+ *   is a terminator, so scans over groups of suffixes could flush
+ *   the last group without a special case.
+ * - an optional sparse table over height[], so the longest common
+ *   prefix of any two suffixes could be queried in O(1).
+ * 
+ * There's no constant size of strings here. Buffers either belong
+ * to the caller, who passes them to sa_init(), or to the suffix
+ * array itself, which allocates and grows them in sa_reserve().
+ * The sparse table always belongs to the caller.
+ * 
+ * The last char of `str` should be a 0 that appears nowhere else,
+ * and other chars should be in range [1, range). Strings could be
+ * made of chars, or of ints for alphabets beyond 127 (the _int
+ * variants), which cost no more than chars to build.
+ * 
+ */
+
+#ifndef SUFFIX_ARRAY_H
+#define SUFFIX_ARRAY_H
+
+struct suffix_array {
+  int len; // length of the string, including the trailing 0
+  int capacity; // max length the buffers could hold
+  int* suffix; // `capacity` ints
+  int* rank; // `capacity` ints
+  int* height; // `capacity`+1 ints
+  int* table; // sparse table, NULL until sa_build_rmq()
+  int levels; // number of levels in `table`
+};
+
+// Point `sa` at caller-owned buffers for strings up to `capacity`.
+void sa_init(struct suffix_array* sa, int* suffix, int* rank, int* height, int capacity);
+
+// Make room for strings up to `len` in buffers owned by `sa`,
+// doubling them as they grow. Start from a zeroed `sa`, and
+// don't mix with buffers passed to sa_init().
+void sa_reserve(struct suffix_array* sa, int len);
+
+// Build suffix[] (by SA-IS), rank[] and height[] (by Kasai's algo).
+// Any sparse table built before is dropped.
+void sa_build(struct suffix_array* sa, const char* str, int len, int range);
+
+// Rebuild rank[] and height[] of `str` from sa->suffix[] alone.
+void sa_build_height(struct suffix_array* sa, const char* str);
+
+// The same on int strings.
+void sa_build_int(struct suffix_array* sa, const int* str, int len, int range);
+void sa_build_height_int(struct suffix_array* sa, const int* str);
+
+// The number of ints a sparse table needs for a string of `len`.
+int sa_rmq_size(int len);
+
+// Build the sparse table over height[] into `table`, which should
+// hold sa_rmq_size(sa->len) ints.
+void sa_build_rmq(struct suffix_array* sa, int* table);
+
+// min(height[l..r]), 0 < l <= r < len. Needs the sparse table.
+int sa_rmq(const struct suffix_array* sa, int l, int r);
+
+// Length of the longest common prefix of suffixes starting at
+// `i` and `j`. Needs the sparse table.
+int sa_lcp(const struct suffix_array* sa, int i, int j);
+
+/*
+ * Builders of suffix[] alone
+ */
+
+// Induced sorting (SA-IS), O(len + range).
+void sa_build_sais(const char* str, int len, int range, int* suffix);
+void sa_build_sais_int(const int* str, int len, int range, int* suffix);
+
+// Prefix doubling with bucket sort, O(len*log(len)).
+// It's slower than SA-IS, and kept for comparison.
+void sa_build_doubling(const char* str, int len, int range, int* suffix);
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Weighted uf-set APIs (C++ only)
+ *
+ * An uf-set where each node also keeps its relation with its parent,
+ * so the relation between any two nodes in the same set could be
+ * derived from their relations with the root. Relations form a group:
+ * the relation of `x` with the root is the sum of relations along the
+ * path, and hanging a root under another one takes the inverse when
+ * it goes the other way around.
+ *
+ * The group is a template parameter, so its arithmetic is inlined
+ * and folded with its constant modulus:
+ *
+ * - cyclic_group<K>: relations add modulo K (POJ 1182, K = 3)
+ * - xor_group: two relations that add by XOR (POJ 1417)
+ *
+ * Each node is a single int: a root holds -(size of its set), and any
+ * other node holds its parent shifted left by Group::bits, with the
+ * relation in the low bits. One node is 4 bytes instead of 12 for
+ * separate parent, relation and size arrays, and find() reads a single
+ * word per step.
+ *
+ * Sets are merged by size and find() compresses paths with two
+ * iterative passes, so there's no recursion and paths stay short.
+ *
+ */
+
+#ifndef WEIGHTED_DSU_H
+#define WEIGHTED_DSU_H
+
+// Relations modulo K.
+template <int K>
+struct cyclic_group {
+  static const int bits = 32 - __builtin_clz(K - 1);
+
+  // Relations are random in general, so these are
+  // branchless: (x >> 31) & K adds K back if x < 0.
+  static int add(int a, int b) {
+    int sum = a + b - K;
+    return sum + ((sum >> 31) & K);
+  }
+
+  static int inverse(int a) {
+    return -a + ((-a >> 31) & K);
+  }
+};
+
+// Two relations, same or different.
+struct xor_group {
+  static const int bits = 1;
+
+  static int add(int a, int b) {
+    return a ^ b;
+  }
+
+  static int inverse(int a) {
+    return a;
+  }
+};
+
+// An uf-set of nodes [0, N] with relations in `Group`.
+template <class Group, int N>
+struct weighted_dsu {
+  static const int mask = (1 << Group::bits) - 1;
+
+  int node[N+1];
+
+  // Make nodes [0, n] singletons, n <= N.
+  void init(int n) {
+    for (int i = 0; i <= n; i++) node[i] = -1;
+  }
+
+  // The relation of `x` with its parent, which is the
+  // root right after find(x). 0 for roots.
+  int relation(int x) const {
+    return node[x] < 0 ? 0 : node[x] & mask;
+  }
+
+  // Find the root of `x`, and hang all nodes on the
+  // path right under it.
+  int find(int x) {
+
+    // Walk up once to find the root, summing relations.
+    int root = x, sum = 0;
+    while (node[root] >= 0) {
+      sum = Group::add(sum, node[root] & mask);
+      root = node[root] >> Group::bits;
+    }
+
+    // Walk up again: `sum` is the relation of the current
+    // node with the root, and the next node's relation is
+    // that minus the relation of the current node with it.
+    while (x != root) {
+      int next = node[x] >> Group::bits;
+      int rx = node[x] & mask;
+      node[x] = root << Group::bits | sum;
+      sum = Group::add(sum, Group::inverse(rx));
+      x = next;
+    }
+
+    return root;
+  }
+
+  // Merge the sets rooted at `a` and `b`, where `b`
+  // has relation `r` with `a`. The smaller one is
+  // hung under the larger one.
+  void merge(int a, int b, int r) {
+    if (node[a] > node[b]) {
+      int t = a; a = b; b = t;
+      r = Group::inverse(r);
+    }
+    node[a] += node[b];
+    node[b] = a << Group::bits | r;
+  }
+};
+
+#endif